@@ -0,0 +1,122 @@
+/*
+	Copyright (c) 2016-2017, Unified Digital Currency
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+	WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/**
+ * @file admission_control.cpp
+ * @author Rafael Afonso Rodrigues <founder@udc.world>
+ * @date 2016
+ * UDC Validating Node.
+ */
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "admission_control.h"
+#include "codes.h"
+#include "globals.h"
+#include "util.h"
+
+
+AdmissionControl::AdmissionControl() : inFlight(0), busyEntities(0) {
+	bucket.tokens = ADMISSION_BURST;
+	bucket.lastRefill = Util::current_timestamp_nanos();
+}
+
+bool AdmissionControl::Admit(const std::string &entityId, uint64_t queueDepth, int &errorCode) {
+	//The processing queue is kept for peer nodes' transactions past this point
+	if(queueDepth >= ADMISSION_QUEUE_LIMIT) {
+		errorCode = ERROR_TRANSACTION_QUEUE_FULL;
+		return false;
+	}
+
+	uint64_t now = Util::current_timestamp_nanos();
+	std::lock_guard<std::mutex> lock(dataMutex);
+
+	auto it = entities.find(entityId);
+	if(it == entities.end()) {
+		it = entities.emplace(entityId, EntityBudgetStruct()).first;
+		it->second.bucket.tokens = ADMISSION_ENTITY_BURST;
+		it->second.bucket.lastRefill = now;
+	}
+	EntityBudgetStruct &entity = it->second;
+
+	//Under load the in-flight budget is shared evenly among the busy entities
+	uint busy = busyEntities + (entity.inFlight ? 0 : 1);
+	uint share = std::min<uint>(ADMISSION_ENTITY_IN_FLIGHT, std::max<uint>(ADMISSION_IN_FLIGHT / busy, 1));
+	if(inFlight >= ADMISSION_IN_FLIGHT || entity.inFlight >= share) {
+		errorCode = ERROR_TRANSACTION_THROTTLED;
+		return false;
+	}
+
+	//Entity's own rate first, so a busy entity doesn't drain the global one
+	if(!Take(entity.bucket, ADMISSION_ENTITY_RATE, ADMISSION_ENTITY_BURST, now)) {
+		errorCode = ERROR_TRANSACTION_THROTTLED;
+		return false;
+	}
+	if(!Take(bucket, ADMISSION_RATE, ADMISSION_BURST, now)) {
+		//give the entity its token back
+		entity.bucket.tokens += 1;
+		errorCode = ERROR_TRANSACTION_THROTTLED;
+		return false;
+	}
+
+	if(!entity.inFlight++) busyEntities++;
+	inFlight++;
+	return true;
+}
+
+void AdmissionControl::Complete(const std::string &entityId) {
+	std::lock_guard<std::mutex> lock(dataMutex);
+
+	auto it = entities.find(entityId);
+	if(it == entities.end() || !it->second.inFlight) return;
+
+	if(!--it->second.inFlight) busyEntities--;
+	inFlight--;
+}
+
+uint AdmissionControl::InFlight() {
+	std::lock_guard<std::mutex> lock(dataMutex);
+	return inFlight;
+}
+
+bool AdmissionControl::Take(TokenBucketStruct &bucket, double rate, double burst, uint64_t now) {
+	//Refill according to the time elapsed since the last submission
+	if(now > bucket.lastRefill) {
+		bucket.tokens = std::min(burst, bucket.tokens + (now - bucket.lastRefill) * rate / 1000000000.0);
+		bucket.lastRefill = now;
+	}
+
+	if(bucket.tokens < 1) return false;
+	bucket.tokens -= 1;
+	return true;
+}
\ No newline at end of file
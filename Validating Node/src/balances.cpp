@@ -35,9 +35,13 @@
  * UDC Validating Node.
  */
 
+#include <atomic>
 #include <cstdint>
 #include <fstream>
+#include <functional>
 #include <mutex>
+#include <set>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -47,24 +51,27 @@
 #include "includes/rocksdb/write_batch.h"
 
 #include "balances.h"
+#include "database.h"
 #include "globals.h"
 #include "transaction.h"
+#include "util.h"
 
 
-Balances::Balances(rocksdb::DB* balancesDB) {
+Balances::Balances(rocksdb::DB* balancesDB, rocksdb::ColumnFamilyHandle *family, rocksdb::ColumnFamilyHandle *metadata) : family(family), metadata(metadata), FLUSH_REQUESTED(false) {
 	db = balancesDB;
+	nextFlush = Util::current_timestamp_nanos() + BALANCES_FLUSH_INTERVAL;
 }
 
 uint64_t Balances::Get(std::string key) {
 	std::string temp;
-    rocksdb::Status status = db->Get(rocksdb::ReadOptions(), key, &temp);
+    rocksdb::Status status = db->Get(rocksdb::ReadOptions(), family, key, &temp);
 
 	if(status.IsNotFound()) return DEFAULT_BALANCE;
-	return std::stoull(temp);
+	return Database::DecodeBalance(temp);
 }
 
 bool Balances::Set(std::string key, uint64_t value) {
-    rocksdb::Status status = db->Put(rocksdb::WriteOptions(), key, std::to_string(value));
+    rocksdb::Status status = db->Put(rocksdb::WriteOptions(), family, key, Database::EncodeBalance(value));
 	return status.ok();
 }
 
@@ -73,98 +80,253 @@ bool Balances::Batch(rocksdb::WriteBatch batch) {
 	return status.ok();
 }
 
+BalancesShardStruct& Balances::Shard(const std::string &account) {
+	return shards[std::hash<std::string>()(account) % BALANCES_SHARDS];
+}
+
+std::vector<std::unique_lock<std::mutex>> Balances::LockAccounts(std::vector<std::pair<std::string, uint64_t>> &from, std::vector<std::pair<std::string, uint64_t>> &to) {
+	std::set<uint> stripes;
+
+	for(auto f = from.begin(); f != from.end(); ++f) stripes.insert(std::hash<std::string>()(f->first) % BALANCES_SHARDS);
+	for(auto t = to.begin(); t != to.end(); ++t) stripes.insert(std::hash<std::string>()(t->first) % BALANCES_SHARDS);
+
+	return LockStripes(stripes);
+}
+
+std::vector<std::unique_lock<std::mutex>> Balances::LockStripes(const std::set<uint> &stripes) {
+	std::vector<std::unique_lock<std::mutex>> locks;
+
+	//always in ascending order, so overlapping updates can't deadlock
+	for(auto stripe = stripes.begin(); stripe != stripes.end(); ++stripe) locks.emplace_back(shards[*stripe].shardMutex);
+	return locks;
+}
+
+void Balances::LoadAll(const std::vector<std::string> &accounts) {
+	std::set<std::string> missing;
+
+	for(auto account = accounts.begin(); account != accounts.end(); ++account) {
+		BalancesShardStruct &shard = Shard(*account);
+		auto it = shard.accounts.find(*account);
+		if(it == shard.accounts.end() || !it->second.KNOWN) missing.insert(*account);
+	}
+	if(missing.size() < 2) return; //a single one is just as well read by Load
+
+	//One lookup for all of them, resolved like Load does
+	std::vector<rocksdb::Slice> keys(missing.begin(), missing.end());
+	std::vector<std::string> values;
+	std::vector<rocksdb::Status> statuses = db->MultiGet(rocksdb::ReadOptions(), std::vector<rocksdb::ColumnFamilyHandle*>(keys.size(), family), keys, &values);
+
+	for(size_t i = 0; i < statuses.size(); i++) {
+		if(!statuses[i].ok() && !statuses[i].IsNotFound()) continue;
+
+		BalanceEntryStruct &entry = Shard(keys[i].ToString()).accounts[keys[i].ToString()];
+		entry.balance = (statuses[i].ok() ? Database::DecodeBalance(values[i]) : DEFAULT_BALANCE) + entry.delta;
+		entry.KNOWN = true;
+	}
+}
+
+void Balances::Prefetch(const std::vector<std::string> &accounts) {
+	std::set<uint> stripes;
+
+	for(auto account = accounts.begin(); account != accounts.end(); ++account) stripes.insert(std::hash<std::string>()(*account) % BALANCES_SHARDS);
+
+	std::vector<std::unique_lock<std::mutex>> locks = LockStripes(stripes);
+	LoadAll(accounts);
+}
+
+uint64_t Balances::Load(BalancesShardStruct &shard, const std::string &account) {
+	auto it = shard.accounts.find(account);
+	if(it != shard.accounts.end() && it->second.KNOWN) return it->second.balance;
+
+	//Stored balance plus whatever was credited since the last flush
+	uint64_t balance = Get(account);
+	if(it == shard.accounts.end()) it = shard.accounts.emplace(account, BalanceEntryStruct()).first;
+	it->second.balance = balance + it->second.delta;
+	it->second.KNOWN = true;
+	return it->second.balance;
+}
+
+void Balances::Apply(BalancesShardStruct &shard, const std::string &account, uint64_t delta) {
+	//An account only credited doesn't need its balance to be read
+	BalanceEntryStruct &entry = shard.accounts[account];
+	entry.delta += delta;
+	if(entry.KNOWN) entry.balance += delta;
+}
+
 uint64_t Balances::GetBalance(std::string account) {
-	dbMutex.lock();
-	return Get(account);
-	dbMutex.unlock();
+	BalancesShardStruct &shard = Shard(account);
+
+	//only the account's stripe, flushes hold every stripe while merging the pending deltas
+	std::lock_guard<std::mutex> lock(shard.shardMutex);
+	return Load(shard, account);
 }
   
 bool Balances::UpdateBalances(std::vector<std::pair<std::string, uint64_t>> &from, std::vector<std::pair<std::string, uint64_t>> &to) {
-	bool updated = false;
-	std::unordered_map<std::string, uint64_t> updatedBalances;
-	uint64_t balance, totalFrom = 0, totalTo = 0;
-	dbMutex.lock();
+	std::unordered_map<std::string, uint64_t> debits;
+	uint64_t totalFrom = 0, totalTo = 0;
 
-	//Ensure senders have enough funds, update balance if they do
 	for(auto f = from.begin(); f != from.end(); ++f) {
 		totalFrom += f->second;
-
-		balance = Get(f->first);
-		if(f->first == WORLD_BANK_ACCOUNT || f->second <= balance) {
-			updatedBalances[f->first] = balance - f->second;
-			continue;
-		}
-		dbMutex.unlock();
-		return false;
+		debits[f->first] += f->second;
 	}
+	for(auto t = to.begin(); t != to.end(); ++t) totalTo += t->second;
+
+	//Ensure equilibrium is maintained
+	if(totalTo != totalFrom) return false;
 
-	//Update receivers' balances
-	for(auto t = to.begin(); t != to.end(); ++t) {
-		totalTo += t->second;
-		
-		balance = Get(t->first);
-		updatedBalances[t->first] = balance + t->second;
+	std::vector<std::unique_lock<std::mutex>> locks = LockAccounts(from, to);
+
+	//Ensure senders have enough funds, only their balances are needed
+	std::vector<std::string> senders;
+	for(auto debit = debits.begin(); debit != debits.end(); ++debit) {
+		if(debit->first != WORLD_BANK_ACCOUNT) senders.push_back(debit->first);
 	}
+	LoadAll(senders);
 
-	//Ensure equilibrium is maintained
-	if(totalTo != totalFrom) {
-		dbMutex.unlock();
-		return false;
+	for(auto debit = debits.begin(); debit != debits.end(); ++debit) {
+		if(debit->first != WORLD_BANK_ACCOUNT && debit->second > Load(Shard(debit->first), debit->first)) return false;
 	}
 
-	//Execute update
-	rocksdb::WriteBatch batch;
-	for(auto op = updatedBalances.begin(); op != updatedBalances.end(); ++op) batch.Put(op->first, std::to_string(op->second));
-	if(Batch(batch)) updated = true;
+	//Execute update as deltas, merged into the database on the next flush
+	for(auto debit = debits.begin(); debit != debits.end(); ++debit) Apply(Shard(debit->first), debit->first, -debit->second);
+	for(auto t = to.begin(); t != to.end(); ++t) Apply(Shard(t->first), t->first, t->second);
 
-	dbMutex.unlock();
-	return updated;
+	return true;
 }
 
 bool Balances::RollbackBalances(std::vector<std::pair<std::string, uint64_t>> &from, std::vector<std::pair<std::string, uint64_t>> &to, bool add /*=false*/) {
-	bool updated = false;
-	std::unordered_map<std::string, uint64_t> updatedBalances;
-	uint64_t balance;
-	dbMutex.lock();
-
-	//Check if its an unregistered transaction
-	if (add) {
-		//Update senders' balances
-		for(auto t = to.begin(); t != to.end(); ++t) {
-			balance = Get(t->first);
-			updatedBalances[t->first] = balance - t->second;
-		}
-		//Update receivers' balances
-		for(auto t = to.begin(); t != to.end(); ++t) {
-			balance = Get(t->first);
-			updatedBalances[t->first] = balance + t->second;
-		}
+	std::vector<std::unique_lock<std::mutex>> locks = LockAccounts(from, to);
+
+	//Check if its an unregistered transaction, otherwise revert it with negated deltas
+	for(auto f = from.begin(); f != from.end(); ++f) Apply(Shard(f->first), f->first, add ? -f->second : f->second);
+	for(auto t = to.begin(); t != to.end(); ++t) Apply(Shard(t->first), t->first, add ? t->second : -t->second);
+
+	return true;
+}
+
+void Balances::UpdateFromLedger(std::unordered_map<std::string,uint64_t> balances) {
+	for(auto it = balances.begin(); it != balances.end(); ++it) {
+		BalancesShardStruct &shard = Shard(it->first);
+		std::lock_guard<std::mutex> lock(shard.shardMutex);
+
+		//written through, the ledger itself is the durable copy
+		Set(it->first, it->second);
+		BalanceEntryStruct &entry = shard.accounts[it->first];
+		entry.balance = it->second;
+		entry.delta = 0;
+		entry.KNOWN = true;
 	}
-	else {
-		//Update senders' balances
-		for(auto t = to.begin(); t != to.end(); ++t) {
-			balance = Get(t->first);
-			updatedBalances[t->first] = balance + t->second;
-		}
-		//Update receivers' balances
-		for(auto t = to.begin(); t != to.end(); ++t) {
-			balance = Get(t->first);
-			updatedBalances[t->first] = balance - t->second;
+}
+
+bool Balances::FlushDue() {
+	return FLUSH_REQUESTED || Util::current_timestamp_nanos() >= nextFlush;
+}
+
+void Balances::RequestFlush() {
+	FLUSH_REQUESTED = true;
+}
+
+bool Balances::Flush(std::function<std::string()> position) {
+	std::vector<std::unique_lock<std::mutex>> locks;
+	FLUSH_REQUESTED = false;
+	nextFlush = Util::current_timestamp_nanos() + BALANCES_FLUSH_INTERVAL;
+
+	//Collect every pending delta, along with the journals' position they reflect
+	rocksdb::WriteBatch batch;
+	std::vector<std::pair<std::string, uint64_t>> flushed;
+	for(uint i = 0; i < BALANCES_SHARDS; i++) {
+		BalancesShardStruct &shard = shards[i];
+		locks.emplace_back(shard.shardMutex); //held until the batch is written
+
+		for(auto it = shard.accounts.begin(); it != shard.accounts.end();) {
+			if(it->second.delta) {
+				batch.Merge(family, it->first, Database::EncodeBalance(it->second.delta));
+				flushed.push_back(std::make_pair(it->first, it->second.delta));
+				it->second.delta = 0;
+			}
+
+			//nothing left for an unread balance, make room by dropping known ones
+			if(!it->second.KNOWN || shard.accounts.size() > BALANCES_CACHE_CAPACITY / BALANCES_SHARDS) {
+				it = shard.accounts.erase(it);
+				continue;
+			}
+			++it;
 		}
 	}
 
-	//Execute update
+	//nothing can be journaled or applied past the deltas collected above
+	std::string journal = position();
+	batch.Put(metadata, BALANCES_JOURNAL_KEY, journal);
+
+	if(Batch(batch)) return true;
+
+	//Keep them pending for the next attempt, cached balances already include them
+	for(auto delta = flushed.begin(); delta != flushed.end(); ++delta) {
+		Shard(delta->first).accounts[delta->first].delta += delta->second; //an evicted entry comes back unread
+	}
+	return false;
+}
+
+void Balances::Recover() {
+	//Runs before any thread is started, no lock is needed
+	std::string journal;
+	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), metadata, BALANCES_JOURNAL_KEY, &journal);
+	if(!status.ok() || journal.empty()) return;
+
+	//Replay the operations journaled after the last flush as deltas
 	rocksdb::WriteBatch batch;
-	for(auto op = updatedBalances.begin(); op != updatedBalances.end(); ++op) batch.Put(op->first, std::to_string(op->second));
-	if(Batch(batch)) updated = true;
-	//else "what if rollback fails?"
+	std::istringstream positions(journal);
+	std::string file, account, operation, recovered;
+	uint64_t offset, amount;
+
+	while(positions >> file >> offset) {
+		std::ifstream operations(file);
+		if(!operations.is_open()) continue;
+
+		operations.seekg(0, std::ios_base::end);
+		uint64_t size = operations.tellg();
+		operations.seekg(offset);
+
+		while((uint64_t)operations.tellg() < size && operations >> account >> operation >> amount) {
+			batch.Merge(family, account, Database::EncodeBalance(operation == "+" ? amount : -amount));
+		}
+		recovered += file + " " + std::to_string(size) + " ";
+	}
 
-	dbMutex.unlock();
-	return updated;
+	//Along with the balances, so a crash before the next flush doesn't replay them again
+	batch.Put(metadata, BALANCES_JOURNAL_KEY, recovered);
+	Batch(batch);
 }
 
-void Balances::UpdateFromLedger(std::unordered_map<std::string,uint64_t> balances) {
-	dbMutex.lock();
-	for(auto it = balances.begin(); it != balances.end(); ++it) Set(it->first, it->second);
-	dbMutex.unlock();
+
+bool Balances::Checkpoint(uint64_t ledgerId, const std::unordered_map<std::string, uint64_t> &movements) {
+	std::string checkpoint;
+	for(auto it = movements.begin(); it != movements.end(); ++it) {
+		if(it->second) checkpoint += it->first + " " + std::to_string(it->second) + " ";
+	}
+
+	//Along with dropping the oldest boundary still kept
+	rocksdb::WriteBatch batch;
+	batch.Put(metadata, BALANCES_CHECKPOINT_KEY + std::to_string(ledgerId), checkpoint);
+	if(ledgerId > BALANCES_CHECKPOINTS) batch.Delete(metadata, BALANCES_CHECKPOINT_KEY + std::to_string(ledgerId - BALANCES_CHECKPOINTS));
+	return Batch(batch);
 }
+
+bool Balances::RestoreCheckpoint(uint64_t ledgerId) {
+	std::string checkpoint;
+	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), metadata, BALANCES_CHECKPOINT_KEY + std::to_string(ledgerId), &checkpoint);
+	if(!status.ok()) return false;
+
+	std::vector<std::unique_lock<std::mutex>> locks;
+	for(uint i = 0; i < BALANCES_SHARDS; i++) locks.emplace_back(shards[i].shardMutex);
+
+	//Revert the ledger's net movements as deltas, persisted by the flush that follows the rollback
+	std::istringstream movements(checkpoint);
+	std::string account;
+	uint64_t movement;
+	while(movements >> account >> movement) Apply(Shard(account), account, -movement);
+
+	//it no longer holds the ledger's operations
+	db->Delete(rocksdb::WriteOptions(), metadata, BALANCES_CHECKPOINT_KEY + std::to_string(ledgerId));
+	return true;
+}
\ No newline at end of file
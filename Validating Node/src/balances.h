@@ -38,7 +38,10 @@
 #ifndef BALANCES_H
 #define BALANCES_H
 
+#include <atomic>
+#include <functional>
 #include <mutex>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -46,10 +49,24 @@
 
 #include "includes/rocksdb/db.h"
 
+#include "globals.h"
+
+
+struct BalanceEntryStruct {
+	uint64_t balance = 0;
+	uint64_t delta = 0; //signed change not yet merged into the database
+	bool KNOWN = false; //balance is only valid once read
+};
+
+//Balances of the accounts whose key falls into it, its lock makes their read-modify-write atomic
+struct BalancesShardStruct {
+	std::mutex shardMutex;
+	std::unordered_map<std::string, BalanceEntryStruct> accounts;
+};
 
 class Balances {
 	public:
-		Balances(rocksdb::DB* balancesDB);
+		Balances(rocksdb::DB* balancesDB, rocksdb::ColumnFamilyHandle *family, rocksdb::ColumnFamilyHandle *metadata);
 
 		uint64_t GetBalance(std::string account);
 		bool UpdateBalances(std::vector<std::pair<std::string, uint64_t>> &from, std::vector<std::pair<std::string, uint64_t>> &to);
@@ -57,16 +74,44 @@ class Balances {
 
 		void UpdateFromLedger(std::unordered_map<std::string,uint64_t> balances);
 
+		//Reads the balances a batch of transactions will check with a single lookup
+		void Prefetch(const std::vector<std::string> &accounts);
+
+		bool FlushDue();
+		void RequestFlush();
+		//The journals' position is read once every shard is locked, no execution may be running meanwhile
+		bool Flush(std::function<std::string()> position);
+		void Recover();
+
+		//Stored once a ledger closed, the last few boundaries can be restored
+		bool Checkpoint(uint64_t ledgerId, const std::unordered_map<std::string, uint64_t> &movements);
+		//Takes out a ledger's operations in one step, no execution may be running meanwhile
+		bool RestoreCheckpoint(uint64_t ledgerId);
+
 	private:
-		std::mutex dbMutex;
-		
 		uint64_t DEFAULT_BALANCE = 0;
 		rocksdb::DB* db;
+		rocksdb::ColumnFamilyHandle *family;
+		rocksdb::ColumnFamilyHandle *metadata; //where the journals position and checkpoints are kept
+
+		//write-back cache, durable through the ledgers' operations journals
+		BalancesShardStruct shards[BALANCES_SHARDS];
+		std::atomic<bool> FLUSH_REQUESTED;
+		std::atomic<uint64_t> nextFlush;
 
 		uint64_t Get(std::string key);
 		bool Set(std::string key, uint64_t value);
 		bool Batch(rocksdb::WriteBatch batch);
+
+		BalancesShardStruct& Shard(const std::string &account);
+		std::vector<std::unique_lock<std::mutex>> LockAccounts(std::vector<std::pair<std::string, uint64_t>> &from, std::vector<std::pair<std::string, uint64_t>> &to);
+		std::vector<std::unique_lock<std::mutex>> LockStripes(const std::set<uint> &stripes);
+
+		//callers hold the shard's lock
+		uint64_t Load(BalancesShardStruct &shard, const std::string &account);
+		void Apply(BalancesShardStruct &shard, const std::string &account, uint64_t delta);
+		void LoadAll(const std::vector<std::string> &accounts);
 };
 
 
-#endif
+#endif
\ No newline at end of file
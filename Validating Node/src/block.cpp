@@ -49,6 +49,7 @@
 #include "configurations.h"
 #include "entry.h"
 #include "globals.h"
+#include "hash160.h"
 #include "merkle.h"
 #include "network_manager.h"
 #include "publisher.h"
@@ -185,44 +186,54 @@ bool Block::NewEntry(Entry *entry) {
 	else if(entry->GetTimestamp() <= nextBlock.end) blockPtr = &nextBlock;
 	else return false;
 
-	blockPtr->entriesList.insert(entry->GetHash());
+	Hash160 id;
+	if(!Hash160::FromHex(entry->GetHash(), id)) return false;
+	Hash160::Insert(blockPtr->entriesList, id);
 	blockPtr->entriesData << ",{\"" << entry->GetHash() << "\':" << entry->GetEntry() << "}";
 	return true;
 }
 
 bool Block::HasEntry(std::string hash) {
-	auto it = currentBlock.entriesList.find(hash);
-	if(it != currentBlock.entriesList.end()) return true;
-
-	auto it2 = nextBlock.entriesList.find(hash);
-	if(it2 != nextBlock.entriesList.end()) return true;
+	Hash160 entry;
+	if(!Hash160::FromHex(hash, entry)) return false;
+	if(Hash160::Contains(currentBlock.entriesList, entry)) return true;
+	if(Hash160::Contains(nextBlock.entriesList, entry)) return true;
 
 	return false;
 }
 
-std::set<std::string> Block::GetLatestEntries() {
+std::vector<Hash160> Block::GetLatestEntries() {
 	return oldEntriesList;
 }
 
 void Block::StartConsensus() {
 	networkManager->BroadcastConfirmation(currentBlock.previousBlockHash);
 
+	Hash160 id;
+	if(!Hash160::FromHex(currentBlock.previousBlockHash, id)) return;
+
 	std::lock_guard<std::mutex> lock(dataMutex);
-	blockConsensus[currentBlock.previousBlockHash].first++;
+	auto &consensus = blockConsensus[id];
+	consensus.first++;
 
-	if(blockConsensus[currentBlock.previousBlockHash].first >= networkManager->ConfirmationThreshold()) {
+	if(consensus.first >= networkManager->ConfirmationThreshold()) {
 		EndConsensus(currentBlock.previousBlockHash, _SELF);
 	}
 }
 
 void Block::AddConfirmation(std::string hash, std::string node) {
+	//malformed hashes would all be counted as the same vote
+	Hash160 id;
+	if(!Hash160::FromHex(hash, id)) return;
+
 	std::lock_guard<std::mutex> lock(dataMutex);
 	
-	blockConsensus[hash].first++;
-	blockConsensus[hash].second.push_back(node);
+	auto &consensus = blockConsensus[id];
+	consensus.first++;
+	consensus.second.push_back(node);
 
-	if(blockConsensus[hash].first >= networkManager->ConfirmationThreshold()) {
-		EndConsensus(hash, node);
+	if(consensus.first >= networkManager->ConfirmationThreshold()) {
+		EndConsensus(id.ToHex(), node);
 	} 
 }
 
@@ -232,8 +243,10 @@ void Block::EndConsensus(std::string hash, std::string node) {
 		//keep the correct hash
 		currentBlock.previousBlockHash = hash;
 
-		//request correct Block from any of the peers that voted for it
-		networkManager->RequestBlock(blockConsensus[hash].second, hash);
+		//request correct Block from any of the peers that voted for it, only decoded hashes reach consensus
+		Hash160 id;
+		Hash160::FromHex(hash, id);
+		networkManager->RequestBlock(blockConsensus[id].second, hash);
 	}
 	else {
 		//irectly publish Block
@@ -263,7 +276,10 @@ void Block::CleanConsensus() {
 }
 
 bool Block::GetCorrectNodes(std::string hash, std::vector<std::string> &nodes) {
-	auto it = blockConsensus.find(hash);
+	Hash160 id;
+	if(!Hash160::FromHex(hash, id)) return false;
+
+	auto it = blockConsensus.find(id);
 	if(it != blockConsensus.end()) {
 		nodes = it->second.second;
 		return true;
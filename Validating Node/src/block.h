@@ -41,11 +41,12 @@
 #include <fstream>
 #include <map>
 #include <mutex>
-#include <set>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "hash160.h"
+
 class Entry;
 class NetworkManager;
 class Publisher;
@@ -60,7 +61,7 @@ struct BlockStruct {
 	uint begin;
 	uint end;
 
-	std::set<std::string> entriesList;
+	std::vector<Hash160> entriesList; //sorted
 
 	std::string blockFile;
 	std::string entriesFile;
@@ -78,7 +79,7 @@ class Block {
 
 		bool NewEntry(Entry *entry);
 		bool HasEntry(std::string hash);
-		std::set<std::string> GetLatestEntries();
+		std::vector<Hash160> GetLatestEntries();
 
 		void StartConsensus();
 		void AddConfirmation(std::string hash, std::string node);
@@ -99,8 +100,8 @@ class Block {
 		BlockStruct currentBlock;
 		BlockStruct nextBlock;
 
-		std::set<std::string> oldEntriesList;
-		std::unordered_map<std::string,std::pair<int,std::vector<std::string>>> blockConsensus;
+		std::vector<Hash160> oldEntriesList;
+		std::unordered_map<Hash160,std::pair<int,std::vector<std::string>>> blockConsensus;
 		
 };
 
@@ -0,0 +1,57 @@
+/*
+	Copyright (c) 2016-2017, Unified Digital Currency
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+	WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/**
+ * @file byte_view.h
+ * @author Rafael Afonso Rodrigues <founder@udc.world>
+ * @date 2016
+ * UDC Validating Node.
+ */
+
+#ifndef BYTE_VIEW_H
+#define BYTE_VIEW_H
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+
+//Bytes owned by someone else, e.g. a field decoded into a transaction's buffer, valid as long as their owner
+struct ByteViewStruct {
+	const char *data;
+	size_t length;
+
+	std::string ToString() const { return std::string(data, length); }
+
+	bool operator==(const ByteViewStruct &other) const { return length == other.length && memcmp(data, other.data, length) == 0; }
+	bool operator!=(const ByteViewStruct &other) const { return !(*this == other); }
+};
+
+#endif
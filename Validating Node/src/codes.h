@@ -69,6 +69,8 @@ static const std::string TX_FUTURE_EXECUTE		= "request";
 #define ERROR_UNSUPPORTED_EVENT				1004
 #define ERROR_UNSUPPORTED_SERVICE			1005
 #define ERROR_HASH							1006
+#define ERROR_TRANSACTION_QUEUE_FULL		1007
+#define ERROR_TRANSACTION_THROTTLED			1008 //retryable, like ERROR_TRANSACTION_QUEUE_FULL
 #define ERROR_TIMESTAMP						2000
 #define ERROR_AMOUNT_SENT					2001
 #define ERROR_FEE_OUTBOUND					2002
@@ -138,6 +140,7 @@ static const std::string TX_FUTURE_EXECUTE		= "request";
 #define NETWORK_BROADCAST_TRANSACTION		0xA104
 #define NETWORK_GET_TRANSACTION				0xA105
 #define NETWORK_TRANSACTION					0xA106
+#define NETWORK_BROADCAST_CONFIRMATIONS		0xA107
 //Ledger
 #define NETWORK_LEDGER_CONSENSUS			0xA200
 #define NETWORK_GET_LEDGER					0xA201
@@ -35,6 +35,7 @@
  * UDC Validating Node.
  */
 
+#include <cstring>
 #include <mutex>
 #include <string>
 #include <sstream>
@@ -52,6 +53,7 @@
 #include "ecdsa.h"
 #include "entity.h"
 #include "globals.h"
+#include "hash160.h"
 #include "keys.h"
 #include "ledger.h"
 #include "network.h"
@@ -201,6 +203,25 @@ void Communication::ListenToNode(bool *IS_OPERATING, bool *IS_SYNCHRONIZED, DAOM
 				break;
 			}
 
+			case NETWORK_BROADCAST_CONFIRMATIONS: {
+				if(offset + NETWORK_CONFIRMATIONS_LENGTH > length) break;
+				uint16_t count;
+				Util::array_to_int(data, NETWORK_CONFIRMATIONS_LENGTH, offset, count);
+				if(count == 0 || count > NODE_CONFIRMATIONS_BATCH || offset + NETWORK_CONFIRMATIONS_LENGTH + count*HASH160_LENGTH > length) break;
+
+				//one signature covers the whole batch
+				std::string batch = Util::array_to_string(data, NETWORK_CONFIRMATIONS_LENGTH + count*HASH160_LENGTH, offset);
+				if(!Crypto::Verify(batch, signature, node->publicKey)) break;
+
+				//each hash counts exactly like an individual confirmation
+				Hash160 hash;
+				for(uint i = 0; i < count; i++) {
+					std::memcpy(hash.bytes, batch.data() + NETWORK_CONFIRMATIONS_LENGTH + i*HASH160_LENGTH, HASH160_LENGTH);
+					txManager->AddConfirmation(hash, node->nodeId);
+				}
+				break;
+			}
+
 			case NETWORK_BROADCAST_TRANSACTION: {
 				if(*IS_SYNCHRONIZED) {
 					int tx_length;
@@ -209,10 +230,19 @@ void Communication::ListenToNode(bool *IS_OPERATING, bool *IS_SYNCHRONIZED, DAOM
 					
 					if(tx_length >= TRANSACTION_MIN_LENGTH && tx_length <= TRANSACTION_MAX_LENGTH) {
 						std::string rawTx = Util::array_to_string(data, tx_length, offset);
+
+						//drop gossip duplicates before verifying or parsing them
+						if(txManager->IsKnown(Transaction::Digest(rawTx))) break;
+						uint64_t received = Util::current_timestamp_nanos();
+
 						if(Crypto::Verify(rawTx, signature, node->publicKey)) {
 							//Load transaction and send for validation
 							Transaction *transaction = Processing::PrepareTransaction(managerDAO, managerDAS, rawTx, errorCode);
-							if(!errorCode) txManager->AddTransaction(transaction, errorCode, true);
+							if(!errorCode) {
+								transaction->Stamp(STAGE_RECEIVED, received);
+								transaction->Stamp(STAGE_PARSED);
+								txManager->AddTransaction(transaction, errorCode, true);
+							}
 						}
 					}
 				}
@@ -250,6 +280,10 @@ void Communication::ListenToNode(bool *IS_OPERATING, bool *IS_SYNCHRONIZED, DAOM
 				if(tx_length >= TRANSACTION_MIN_LENGTH+TRANSACTION_HASH_LENGTH && tx_length <= TRANSACTION_MAX_LENGTH) {
 					std::string rawTx = Util::array_to_string(data, tx_length, offset);
 
+					//malformed, or already received from another peer meanwhile
+					Hash160 id;
+					if(!Hash160::FromHex(rawTx.substr(2, TRANSACTION_HASH_LENGTH), id) || txManager->IsKnown(id)) break;
+
 					if(Crypto::Verify(rawTx, signature, node->publicKey)) {
 						std::string hash, coreTx;
 						hash = rawTx.substr(2, TRANSACTION_HASH_LENGTH);
@@ -506,14 +540,29 @@ void Communication::ListenToEntity(bool *IS_OPERATING, bool *IS_SYNCHRONIZED, DA
 					offset += NETWORK_TRANSACTION_LENGTH;
 
 					if(tx_length >= TRANSACTION_MIN_LENGTH+TRANSACTION_HASH_LENGTH && tx_length <= TRANSACTION_MAX_LENGTH) {
+						uint64_t received = Util::current_timestamp_nanos();
+
+						//refuse early while over budget, the entity may retry later
+						if(!txManager->AdmitSubmission(entity->entityId, errorCode)) {
+							dataMutex.lock();
+							Network::WriteMessage(*entity->socket, NETWORK_TRANSACTION_REJECTED, hash+std::to_string(errorCode), true);
+							dataMutex.unlock();
+							break;
+						}
+
+						bool submitted = false;
 						std::string newTx = Util::array_to_string(data, tx_length, offset);
 
 						if(Crypto::Verify(hash+newTx, signature, entity->publicKey)) {
 							Transaction *transaction = Processing::PrepareTransaction(managerDAO, managerDAS, newTx, errorCode);
 
 							if(!errorCode) {
+								transaction->Stamp(STAGE_RECEIVED, received);
+								transaction->Stamp(STAGE_PARSED);
+
 								if(hash != transaction->GetHash()) errorCode = ERROR_HASH;
 								else if(txManager->AddTransaction(transaction, errorCode, true, DISPATCHER_ENTITY, entity->entityId)) {
+									submitted = true;
 									dataMutex.lock();
 									Network::WriteMessage(*entity->socket, NETWORK_TRANSACTION_ACCEPTED, hash, true);
 									dataMutex.unlock();
@@ -526,6 +575,9 @@ void Communication::ListenToEntity(bool *IS_OPERATING, bool *IS_SYNCHRONIZED, DA
 								dataMutex.unlock();
 							}
 						}
+
+						//Release the budget of submissions that won't get a validation reply
+						if(!submitted) txManager->CancelSubmission(entity->entityId);
 					}
 				}
 				else {
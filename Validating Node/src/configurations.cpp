@@ -39,6 +39,7 @@
 #include <chrono>
 #include <string>
 #include <iostream>
+#include <sstream>
 #include <thread>
 #include <string>
 
@@ -50,6 +51,20 @@
 #include "network.h"
 
 
+unsigned int _VERIFICATION_WORKERS = DEFAULT_VERIFICATION_WORKERS;
+unsigned int _EXECUTION_WORKERS = DEFAULT_EXECUTION_WORKERS;
+unsigned int _DATABASE_CACHE_BUDGET = DEFAULT_DATABASE_CACHE_BUDGET;
+unsigned int _DATABASE_WRITE_BUFFER = DEFAULT_DATABASE_WRITE_BUFFER;
+unsigned int _DATABASE_BLOOM_BITS = DEFAULT_DATABASE_BLOOM_BITS;
+
+static const TuningStruct TUNING[] = {
+	{"verification_workers", &_VERIFICATION_WORKERS, 0, 1024, "threads checking transactions ahead of processing, 0 uses one per core"},
+	{"execution_workers", &_EXECUTION_WORKERS, 0, 1024, "threads applying non-conflicting transactions, 0 uses one per core"},
+	{"database_cache_budget", &_DATABASE_CACHE_BUDGET, 8, 1048576, "MB shared by all databases' block caches and memtables"},
+	{"database_write_buffer", &_DATABASE_WRITE_BUFFER, 1, 4096, "MB per memtable of the write heavy databases"},
+	{"database_bloom_bits", &_DATABASE_BLOOM_BITS, 1, 64, "bloom filter bits per key"}
+};
+
 bool LoadConfigurations() {
 	Configurations config;
 
@@ -76,6 +91,65 @@ void SaveConfigurations() {
 	file.close();
 }
 
+void LoadTuning() {
+	std::fstream file(TUNING_FILE, std::fstream::in);
+	//first start, write the defaults out so they can be edited
+	if(!file.good()) {
+		SaveTuning();
+		return;
+	}
+
+	std::string line;
+	uint number = 0;
+	while(std::getline(file, line)) {
+		number++;
+
+		//skip blank lines and comments
+		size_t start = line.find_first_not_of(" \t\r");
+		if(start == std::string::npos || line[start] == '#') continue;
+
+		//spaces around the equals sign are optional
+		size_t equals = line.find('=');
+		if(equals != std::string::npos) line.replace(equals, 1, " = ");
+
+		std::string key, separator, value, rest;
+		std::istringstream setting(line);
+		setting >> key >> separator >> value;
+		if(separator != "=" || value.empty() || setting >> rest) {
+			std::cout << TUNING_FILE << ":" << number << ": expected \"key = value\", ignored" << std::endl;
+			continue;
+		}
+
+		const TuningStruct *tuning = NULL;
+		for(uint i = 0; i < sizeof(TUNING) / sizeof(TUNING[0]); i++) {
+			if(key == TUNING[i].key) tuning = &TUNING[i];
+		}
+		if(!tuning) {
+			std::cout << TUNING_FILE << ":" << number << ": unknown setting " << key << ", ignored" << std::endl;
+			continue;
+		}
+
+		//digits only, short enough not to overflow, within the setting's range
+		if(value.find_first_not_of("0123456789") != std::string::npos || value.length() > 9 || std::stoul(value) < tuning->minimum || std::stoul(value) > tuning->maximum) {
+			std::cout << TUNING_FILE << ":" << number << ": " << key << " must be between " << tuning->minimum << " and " << tuning->maximum << ", keeping " << *tuning->value << std::endl;
+			continue;
+		}
+		*tuning->value = std::stoul(value);
+	}
+	file.close();
+}
+
+void SaveTuning() {
+	std::fstream file(TUNING_FILE, std::fstream::out | std::fstream::trunc);
+	file << "# node tuning, read on start up; a missing or invalid setting keeps its default" << std::endl;
+
+	for(uint i = 0; i < sizeof(TUNING) / sizeof(TUNING[0]); i++) {
+		file << std::endl << "# " << TUNING[i].description << " (" << TUNING[i].minimum << " to " << TUNING[i].maximum << ")" << std::endl;
+		file << TUNING[i].key << " = " << *TUNING[i].value << std::endl;
+	}
+	file.close();
+}
+
 bool CreateProfile() {
 	bool correct = false;
 
@@ -43,12 +43,20 @@
 #include "globals.h"
 
 #define CONFIGURATION_FILE "node.cfg"
+#define TUNING_FILE "tuning.cfg"
 static std::string _SELF;
 static unsigned int _PORT = DEFAULT_NODE_PORT;
 static std::string _ACCOUNT = WORLD_BANK_NODE_ACCOUNT;
 //node keys location
 static std::string _ECDSA_PRIVATE_KEY = LOCAL_DATA_KEYS+"ecdsa_private.der";
 static std::string _ECDSA_PUBLIC_KEY = LOCAL_DATA_KEYS+"ecdsa_public.der";
+//processing settings, shared across all translation units
+extern unsigned int _VERIFICATION_WORKERS;
+extern unsigned int _EXECUTION_WORKERS;
+//databases tuning
+extern unsigned int _DATABASE_CACHE_BUDGET;
+extern unsigned int _DATABASE_WRITE_BUFFER;
+extern unsigned int _DATABASE_BLOOM_BITS;
 
 struct Configurations {
 	std::string id;
@@ -58,9 +66,21 @@ struct Configurations {
 	std::string account;
 };
 
+//One tuning setting as written in the tuning file, along with the values it accepts
+struct TuningStruct {
+	const char *key;
+	unsigned int *value;
+	unsigned int minimum;
+	unsigned int maximum;
+	const char *description;
+};
+
 
 bool LoadConfigurations();
 void SaveConfigurations();
 bool CreateProfile();
+//plain text "key = value" lines, a missing or invalid setting keeps its default
+void LoadTuning();
+void SaveTuning();
 
 #endif
\ No newline at end of file
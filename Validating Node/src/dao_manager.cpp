@@ -37,11 +37,14 @@
 
 #include <algorithm>
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "includes/rapidjson/document.h"
+
 #include "codes.h"
 #include "dao_manager.h"
 #include "dao_module.h"
@@ -76,23 +79,21 @@ void DAOManager::Stop() {
 	for(auto it = modules.begin(); it != modules.end(); ++it) it->second.module->Stop();
 }
 
-Transaction* DAOManager::Create(std::string &rawTx, int &errorCode) {
-	Transaction *transaction = new DAOTransaction(rawTx.c_str());
-	if(transaction->IsTransaction()) {
+Transaction* DAOManager::Create(std::string &rawTx, rapidjson::Document &document, std::shared_ptr<TransactionArena> arena, int &errorCode) {
+	//Find the DAO it pertains to
+	if(!document.HasMember("DAO") || !document["DAO"].IsString()) {
 		errorCode = ERROR_TRANSACTION_INVALID;
-		return transaction;
+		return NULL;
 	}
+	std::string DAO = document["DAO"].GetString();
+
+	//Modules decode their own transactions
+	auto it = modules.find(DAO);
+	if(it != modules.end()) return it->second.module->Create(rawTx, errorCode);
+	else if(DAO == DAO_BASE_ID) return new FeeRedistributionDAOTransaction(document, arena);
 
-	auto it = modules.find(dynamic_cast<DAOTransaction*>(transaction)->GetDAO());
-	if(it != modules.end()) {
-		delete transaction;
-		return it->second.module->Create(rawTx, errorCode);
-	}
-	else if(dynamic_cast<DAOTransaction*>(transaction)->GetDAO() == DAO_BASE_ID) {
-		return new FeeRedistributionDAOTransaction(rawTx.c_str());
-	}
 	errorCode = ERROR_UNSUPPORTED_SERVICE;
-	return transaction;
+	return NULL;
 }
 
 bool DAOManager::Process(DAOTransaction *transaction, int &errorCode) {
@@ -39,17 +39,21 @@
 #define DAO_MANAGER_H
 
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "includes/rapidjson/document.h"
+
 class DAOModule;
 class DAOTransaction;
 class ModulesInterface;
 class Nodes;
 class Transaction;
+class TransactionArena;
 class TransactionsManager;
 
 
@@ -70,7 +74,7 @@ class DAOManager {
 		void Launch(ModulesInterface *interface);
 		void Stop();
 
-		Transaction* Create(std::string &rawTx, int &errorCode);
+		Transaction* Create(std::string &rawTx, rapidjson::Document &document, std::shared_ptr<TransactionArena> arena, int &errorCode);
 		bool Process(DAOTransaction *transaction, int &errorCode);
 		void Execute(DAOTransaction *transaction, std::vector<std::pair<std::string, uint64_t>> &from, std::vector<std::pair<std::string, uint64_t>> &to);
 		bool Allow(std::string DAO, std::vector<std::pair<std::string, uint64_t>> &from, std::vector<std::pair<std::string, uint64_t>> &to, int &errorCode);
@@ -37,11 +37,14 @@
 
 #include <algorithm>
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "includes/rapidjson/document.h"
+
 #include "codes.h"
 #include "das_manager.h"
 #include "das_module.h"
@@ -76,23 +79,21 @@ void DASManager::Stop() {
 	for(auto it = modules.begin(); it != modules.end(); ++it) it->second.module->Stop();
 }
 
-Transaction* DASManager::Create(std::string &rawTx, int &errorCode) {
-	Transaction *transaction = new DASTransaction(rawTx.c_str());
-	if(transaction->IsTransaction()) {
+Transaction* DASManager::Create(std::string &rawTx, rapidjson::Document &document, std::shared_ptr<TransactionArena> arena, int &errorCode) {
+	//Find the DAS it pertains to
+	if(!document.HasMember("DAS") || !document["DAS"].IsString()) {
 		errorCode = ERROR_TRANSACTION_INVALID;
-		return transaction;
+		return NULL;
 	}
+	std::string DAS = document["DAS"].GetString();
+
+	//Modules decode their own transactions
+	auto it = modules.find(DAS);
+	if(it != modules.end()) return it->second.module->Create(rawTx, errorCode);
+	else if(DAS == DAS_BASE_ID) return new FeeRedistributionDASTransaction(document, arena);
 
-	auto it = modules.find(dynamic_cast<DASTransaction*>(transaction)->GetDAS());
-	if(it != modules.end()) {
-		delete transaction;
-		return it->second.module->Create(rawTx, errorCode);
-	}
-	else if(dynamic_cast<DASTransaction*>(transaction)->GetDAS() == DAS_BASE_ID) {
-		return new FeeRedistributionDASTransaction(rawTx.c_str());
-	}
 	errorCode = ERROR_UNSUPPORTED_SERVICE;
-	return transaction;
+	return NULL;
 }
 
 bool DASManager::Process(DASTransaction *transaction, int &errorCode) {
@@ -35,16 +35,27 @@
  * UDC Validating Node.
  */
 
+#include <algorithm>
 #include <string>
 #include <cstdint>
 #include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
 
+#include "includes/rocksdb/cache.h"
 #include "includes/rocksdb/db.h"
+#include "includes/rocksdb/filter_policy.h"
+#include "includes/rocksdb/merge_operator.h"
+#include "includes/rocksdb/slice_transform.h"
+#include "includes/rocksdb/table.h"
+#include "includes/rocksdb/write_buffer_manager.h"
 #include "includes/rocksdb/write_batch.h"
 #include "includes/rocksdb/utilities/backupable_db.h"
 #include "includes/boost/filesystem.hpp"
 
 #include "codes.h"
+#include "configurations.h"
 #include "database.h"
 #include "globals.h"
 
@@ -52,87 +63,278 @@
 #include <string>
 
 
-rocksdb::DB* Database::LoadNetworkManagementDB() {
-	rocksdb::DB *db;
-	rocksdb::Options options;
-	//Try to open database
-	rocksdb::Status status = rocksdb::DB::Open(options, DATABASE_NETWORK_MANAGEMENT, &db);
-
-	if(!status.ok()) {
-		//Otherwise create a new one
-		options.create_if_missing = true;
-		status = rocksdb::DB::Open(options, DATABASE_NETWORK_MANAGEMENT, &db);
-		assert(status.ok());
+//Column family of each store, indexed by its profile, along with the standalone database it used to be
+static const std::string FAMILY_NAMES[DATABASE_FAMILIES] = {"network_management", "account_balances", "public_keys", "account_slots"};
+static const std::string LEGACY_STORES[DATABASE_FAMILIES] = {DATABASE_NETWORK_MANAGEMENT, DATABASE_BALANCES, DATABASE_PUBLIC_KEYS, DATABASE_SLOTS};
+static std::vector<rocksdb::ColumnFamilyHandle*> families;
 
-		//try to restore using an eventual backup database
-		rocksdb::BackupEngine* backup_engine;
-		status = rocksdb::BackupEngine::Open(rocksdb::Env::Default(), rocksdb::BackupableDBOptions(DATABASE_NETWORK_MANAGEMENT_BACKUP), &backup_engine);
-	    if(status.ok()) {
-	    	std::cout << "restoring from backup" << std::endl;
-		    backup_engine->RestoreDBFromLatestBackup(DATABASE_NETWORK_MANAGEMENT, DATABASE_NETWORK_MANAGEMENT);
-		    delete backup_engine;
-		}
-	}
+static std::shared_ptr<rocksdb::Cache> SharedCache() {
+	//a single budget, memtables are charged to the block cache they share
+	static std::shared_ptr<rocksdb::Cache> cache = rocksdb::NewLRUCache((size_t)_DATABASE_CACHE_BUDGET << 20);
+	return cache;
+}
 
-	return db;
+static rocksdb::DB* CloseNodeDB(rocksdb::DB *db) {
+	//a partly loaded database is never handed out
+	for(auto family = families.begin(); family != families.end(); ++family) db->DestroyColumnFamilyHandle(*family);
+	families.clear();
+	delete db;
+	return nullptr;
 }
 
-rocksdb::DB* Database::LoadBalancesDB() {
-	rocksdb::DB *db;
-	rocksdb::Options options;
+rocksdb::ColumnFamilyOptions Database::Profile(int profile) {
+	rocksdb::ColumnFamilyOptions options;
+	rocksdb::BlockBasedTableOptions table;
+	table.block_cache = SharedCache();
+	table.cache_index_and_filter_blocks = true;
+	table.pin_l0_filter_and_index_blocks_in_cache = true;
 
-	options.create_if_missing = true;
-	//options.merge_operator.reset(new AdditionMergeOperator());
-	rocksdb::Status status = rocksdb::DB::Open(options, DATABASE_BALANCES, &db);
-	assert(status.ok());
+	switch(profile) {
+		case DATABASE_PROFILE_NETWORK_MANAGEMENT:
+			//entries of the same resource are looked up together
+			options.prefix_extractor.reset(new MaskPrefixTransform());
+			options.memtable_prefix_bloom_size_ratio = 0.05;
+			table.filter_policy.reset(rocksdb::NewBloomFilterPolicy(_DATABASE_BLOOM_BITS, false));
+			table.whole_key_filtering = true;
+			options.compaction_style = rocksdb::kCompactionStyleLevel;
+			options.write_buffer_size = ((size_t)_DATABASE_WRITE_BUFFER << 20) / 4;
+			break;
 
-	return db;
+		case DATABASE_PROFILE_BALANCES:
+			//every transaction reads and merges, keep more of it in memory
+			options.merge_operator.reset(new BalanceMergeOperator());
+			table.filter_policy.reset(rocksdb::NewBloomFilterPolicy(_DATABASE_BLOOM_BITS, false));
+			options.compaction_style = rocksdb::kCompactionStyleLevel;
+			options.level_compaction_dynamic_level_bytes = true;
+			options.write_buffer_size = (size_t)_DATABASE_WRITE_BUFFER << 20;
+			options.max_write_buffer_number = 4;
+			options.min_write_buffer_number_to_merge = 2;
+			options.max_successive_merges = 64;
+			break;
+
+		case DATABASE_PROFILE_KEYS:
+			//looked up on every verification, written once per account
+			table.filter_policy.reset(rocksdb::NewBloomFilterPolicy(_DATABASE_BLOOM_BITS, false));
+			options.compaction_style = rocksdb::kCompactionStyleLevel;
+			options.write_buffer_size = ((size_t)_DATABASE_WRITE_BUFFER << 20) / 4;
+			break;
+
+		case DATABASE_PROFILE_SLOTS:
+			//a few thousand entries, rarely changed
+			options.compaction_style = rocksdb::kCompactionStyleUniversal;
+			options.compression = rocksdb::kNoCompression;
+			options.write_buffer_size = ((size_t)_DATABASE_WRITE_BUFFER << 20) / 16;
+			break;
+	}
+
+	options.table_factory.reset(rocksdb::NewBlockBasedTableFactory(table));
+	return options;
 }
 
-rocksdb::DB* Database::LoadKeysDB() {
+rocksdb::DB* Database::LoadNodeDB() {
 	rocksdb::DB *db;
-	rocksdb::Options options;
-	//Try to open database
-	rocksdb::Status status = rocksdb::DB::Open(options, DATABASE_PUBLIC_KEYS, &db);
+	rocksdb::DBOptions options;
+	std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
 
-	if(!status.ok()) {
-		//Otherwise create a new one
-		options.create_if_missing = true;
-		status = rocksdb::DB::Open(options, DATABASE_PUBLIC_KEYS, &db);
-		assert(status.ok());
+	//One WAL and one background pool for all the stores
+	options.create_if_missing = true;
+	options.create_missing_column_families = true;
+	options.IncreaseParallelism(std::max(std::thread::hardware_concurrency(), 2u));
+	options.write_buffer_manager = std::make_shared<rocksdb::WriteBufferManager>(((size_t)_DATABASE_CACHE_BUDGET << 20) / 2, SharedCache());
 
-		//try to restore using an eventual backup database
+	descriptors.push_back(rocksdb::ColumnFamilyDescriptor(rocksdb::kDefaultColumnFamilyName, rocksdb::ColumnFamilyOptions()));
+	for(uint i = 0; i < DATABASE_FAMILIES; i++) descriptors.push_back(rocksdb::ColumnFamilyDescriptor(FAMILY_NAMES[i], Profile(i)));
+
+	//try to restore using an eventual backup database
+	if(!boost::filesystem::exists(DATABASE_NODE)) {
 		rocksdb::BackupEngine* backup_engine;
-		status = rocksdb::BackupEngine::Open(rocksdb::Env::Default(), rocksdb::BackupableDBOptions(DATABASE_PUBLIC_KEYS_BACKUP), &backup_engine);
+		rocksdb::Status status = rocksdb::BackupEngine::Open(rocksdb::Env::Default(), rocksdb::BackupableDBOptions(DATABASE_NODE_BACKUP), &backup_engine);
 	    if(status.ok()) {
 	    	std::cout << "restoring from backup" << std::endl;
-		    backup_engine->RestoreDBFromLatestBackup(DATABASE_PUBLIC_KEYS, DATABASE_PUBLIC_KEYS);
+		    backup_engine->RestoreDBFromLatestBackup(DATABASE_NODE, DATABASE_NODE);
 		    delete backup_engine;
 		}
 	}
 
-	return db;
-}
+	rocksdb::Status status = rocksdb::DB::Open(options, DATABASE_NODE, descriptors, &families, &db);
+	if(!status.ok()) {
+		std::cout << "ERROR: couldn't open " << DATABASE_NODE << ": " << status.ToString() << std::endl;
+		return nullptr;
+	}
 
-rocksdb::DB* Database::LoadSlotsDB() {
-	rocksdb::DB *db;
-	rocksdb::Options options;
-	rocksdb::Status status = rocksdb::DB::Open(options, DATABASE_SLOTS, &db);
+	//Bring in the standalone databases of previous versions
+	for(uint i = 0; i < DATABASE_FAMILIES; i++) {
+		if(!boost::filesystem::exists(LEGACY_STORES[i]+"/CURRENT")) continue;
 
-	if(!status.ok()) {
-		//Create a new database if it doesn't exists
-		options.create_if_missing = true;
-		status = rocksdb::DB::Open(options, DATABASE_SLOTS, &db);
-		assert(status.ok());
+		if(!ImportStore(db, Family(i), LEGACY_STORES[i], Profile(i))) {
+			std::cout << "ERROR: couldn't import " << LEGACY_STORES[i] << std::endl;
+			return CloseNodeDB(db);
+		}
+		boost::filesystem::rename(LEGACY_STORES[i], LEGACY_STORES[i]+".imported");
+	}
+
+	//Convert balances stored by previous versions
+	if(!MigrateBalancesDB(db, Family(DATABASE_PROFILE_BALANCES), Metadata())) {
+		std::cout << "ERROR: couldn't migrate the balances database" << std::endl;
+		return CloseNodeDB(db);
+	}
 
-		//Repopulate with the Slots backup file
+	//Repopulate an empty Slots store with the Slots backup file
+	std::unique_ptr<rocksdb::Iterator> it(db->NewIterator(rocksdb::ReadOptions(), Family(DATABASE_PROFILE_SLOTS)));
+	it->SeekToFirst();
+	if(!it->Valid()) {
 		std::fstream slotsData(LOCAL_DATA_SLOTS, std::fstream::in);
 		if(slotsData.good()) {
 			std::string key, value;
-			while(slotsData >> key >> value) db->Put(rocksdb::WriteOptions(), key, value);
+			while(slotsData >> key >> value) db->Put(rocksdb::WriteOptions(), Family(DATABASE_PROFILE_SLOTS), key, value);
 		}
 		slotsData.close();
 	}
 
 	return db;
+}
+
+rocksdb::ColumnFamilyHandle* Database::Family(int profile) {
+	//the default family comes first
+	return families.at(profile + 1);
+}
+
+rocksdb::ColumnFamilyHandle* Database::Metadata() {
+	//the stores' own bookkeeping, kept out of their keyspaces
+	return families.at(0);
+}
+
+bool Database::ImportStore(rocksdb::DB *db, rocksdb::ColumnFamilyHandle *family, std::string path, rocksdb::ColumnFamilyOptions profile) {
+	rocksdb::DB *legacy;
+	rocksdb::WriteBatch batch;
+	uint copied = 0;
+
+	rocksdb::Status status = rocksdb::DB::OpenForReadOnly(rocksdb::Options(rocksdb::DBOptions(), profile), path, &legacy);
+	if(!status.ok()) return false;
+	std::cout << "importing " << path << std::endl;
+
+	//keys are copied as they are, importing twice is harmless
+	rocksdb::ReadOptions readOptions;
+	readOptions.total_order_seek = true;
+	std::unique_ptr<rocksdb::Iterator> it(legacy->NewIterator(readOptions));
+	for(it->SeekToFirst(); it->Valid(); it->Next()) {
+		batch.Put(family, it->key(), it->value());
+
+		if(++copied % DATABASE_IMPORT_BATCH == 0) {
+			if(!db->Write(rocksdb::WriteOptions(), &batch).ok()) break;
+			batch.Clear();
+		}
+	}
+
+	bool IMPORTED = it->status().ok() && db->Write(rocksdb::WriteOptions(), &batch).ok();
+	it.reset();
+	delete legacy;
+	return IMPORTED;
+}
+
+bool Database::BackupData(rocksdb::DB *db) {
+	rocksdb::BackupEngine* backup_engine;
+
+	//backups are incremental, files shared with the previous one are not copied again
+	rocksdb::Status status = rocksdb::BackupEngine::Open(rocksdb::Env::Default(), rocksdb::BackupableDBOptions(DATABASE_NODE_BACKUP), &backup_engine);
+	if(!status.ok()) return false;
+
+	status = backup_engine->CreateNewBackup(db);
+	delete backup_engine;
+	return status.ok();
+}
+
+bool Database::MigrateBalancesDB(rocksdb::DB *db, rocksdb::ColumnFamilyHandle *family, rocksdb::ColumnFamilyHandle *metadata) {
+	std::string version, resume, key;
+	rocksdb::WriteBatch batch;
+	uint converted = 0;
+
+	//Only the stored version tells the format, balances of both can look alike
+	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), metadata, BALANCES_VERSION_KEY, &version);
+	if(!status.ok() && !status.IsNotFound()) return false;
+	if(status.ok() && DecodeBalance(version) >= BALANCES_FORMAT_VERSION) return true;
+
+	//Pick up after the last resume point, if a previous migration was interrupted
+	status = db->Get(rocksdb::ReadOptions(), metadata, BALANCES_MIGRATION_KEY, &resume);
+	if(!status.ok() && !status.IsNotFound()) return false;
+	std::cout << "migrating balances database" << std::endl;
+
+	std::unique_ptr<rocksdb::Iterator> it(db->NewIterator(rocksdb::ReadOptions(), family));
+	if(resume.empty()) it->SeekToFirst();
+	else it->Seek(resume);
+
+	for(; it->Valid(); it->Next()) {
+		key = it->key().ToString();
+		if(key == resume) continue;
+
+		//everything past the resume point is still a decimal string
+		std::string value = it->value().ToString();
+		if(value.empty() || value.find_first_not_of("0123456789") != std::string::npos) {
+			std::cout << "ERROR: balance of " << key << " isn't in the previous format" << std::endl;
+			return false;
+		}
+		batch.Put(family, key, EncodeBalance(std::stoull(value)));
+
+		if(++converted % BALANCES_MIGRATION_BATCH == 0) {
+			batch.Put(metadata, BALANCES_MIGRATION_KEY, key);
+			if(!db->Write(rocksdb::WriteOptions(), &batch).ok()) return false;
+			batch.Clear();
+		}
+	}
+	if(!it->status().ok()) return false;
+
+	batch.Put(metadata, BALANCES_VERSION_KEY, EncodeBalance(BALANCES_FORMAT_VERSION));
+	batch.Delete(metadata, BALANCES_MIGRATION_KEY);
+	if(!db->Write(rocksdb::WriteOptions(), &batch).ok()) return false;
+
+	std::cout << converted << " balances migrated" << std::endl;
+	return true;
+}
+
+std::string Database::EncodeBalance(uint64_t balance) {
+	//little-endian, regardless of the host
+	std::string value(8, 0);
+	for(uint i = 0; i < 8; i++) value[i] = (char)(balance >> (i*8));
+	return value;
+}
+
+uint64_t Database::DecodeBalance(const rocksdb::Slice &value) {
+	uint64_t balance = 0;
+	for(uint i = 0; i < 8 && i < value.size(); i++) balance |= (uint64_t)(unsigned char)value[i] << (i*8);
+	return balance;
+}
+
+bool BalanceMergeOperator::Merge(const rocksdb::Slice &key, const rocksdb::Slice *existingValue, const rocksdb::Slice &value, std::string *newValue, rocksdb::Logger *logger) const {
+	uint64_t balance = existingValue ? Database::DecodeBalance(*existingValue) : 0;
+
+	//Signed deltas wrap around like the unsigned balances they apply to
+	*newValue = Database::EncodeBalance(balance + Database::DecodeBalance(value));
+	return true;
+}
+
+const char* BalanceMergeOperator::Name() const {
+	return "BalanceMergeOperator";
+}
+
+const char* MaskPrefixTransform::Name() const {
+	return "MaskPrefixTransform";
+}
+
+rocksdb::Slice MaskPrefixTransform::Transform(const rocksdb::Slice &key) const {
+	for(size_t i = 0; i < key.size(); i++) {
+		if(key[i] == NMDB_MASK_DELIMITER.at(0)) return rocksdb::Slice(key.data(), i);
+	}
+	//keys without a mask are their own prefix
+	return key;
+}
+
+bool MaskPrefixTransform::InDomain(const rocksdb::Slice &key) const {
+	return true;
+}
+
+bool MaskPrefixTransform::InRange(const rocksdb::Slice &prefix) const {
+	for(size_t i = 0; i < prefix.size(); i++) {
+		if(prefix[i] == NMDB_MASK_DELIMITER.at(0)) return false;
+	}
+	return true;
 }
\ No newline at end of file
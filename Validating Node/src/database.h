@@ -38,18 +38,46 @@
 #ifndef DATABASE_H
 #define DATABASE_H
 
-//#include <string>
-//#include <cstdint>
+#include <string>
+#include <cstdint>
 
 #include "includes/rocksdb/db.h"
-//#include "includes/rocksdb/merge_operator.h"
+#include "includes/rocksdb/merge_operator.h"
+#include "includes/rocksdb/options.h"
+#include "includes/rocksdb/slice_transform.h"
+
+
+//Adds signed 8 bytes deltas to a balance, so updates are written without reading it first
+class BalanceMergeOperator : public rocksdb::AssociativeMergeOperator {
+	public:
+		virtual bool Merge(const rocksdb::Slice &key, const rocksdb::Slice *existingValue, const rocksdb::Slice &value, std::string *newValue, rocksdb::Logger *logger) const override;
+		virtual const char* Name() const override;
+};
+
+//Groups the network management keys by what precedes their first mask delimiter, e.g. an entity's id
+class MaskPrefixTransform : public rocksdb::SliceTransform {
+	public:
+		virtual const char* Name() const override;
+		virtual rocksdb::Slice Transform(const rocksdb::Slice &key) const override;
+		virtual bool InDomain(const rocksdb::Slice &key) const override;
+		virtual bool InRange(const rocksdb::Slice &prefix) const override;
+};
 
 namespace Database {
 
-rocksdb::DB* LoadNetworkManagementDB();
-rocksdb::DB* LoadBalancesDB();
-rocksdb::DB* LoadKeysDB();
-rocksdb::DB* LoadSlotsDB();
+rocksdb::ColumnFamilyOptions Profile(int profile);
+
+//A single instance, each store being one of its column families, null if it couldn't be loaded
+rocksdb::DB* LoadNodeDB();
+rocksdb::ColumnFamilyHandle* Family(int profile);
+rocksdb::ColumnFamilyHandle* Metadata();
+bool ImportStore(rocksdb::DB *db, rocksdb::ColumnFamilyHandle *family, std::string path, rocksdb::ColumnFamilyOptions profile);
+bool BackupData(rocksdb::DB *db);
+
+bool MigrateBalancesDB(rocksdb::DB *db, rocksdb::ColumnFamilyHandle *family, rocksdb::ColumnFamilyHandle *metadata);
+
+std::string EncodeBalance(uint64_t balance);
+uint64_t DecodeBalance(const rocksdb::Slice &value);
 
 }
 
@@ -35,9 +35,12 @@
  * UDC Validating Node.
  */
 
+#include <map>
+#include <memory>
 #include <string>
 #include <sstream>
 #include <iostream>
+#include <vector>
 
 #include "includes/cryptopp/eccrypto.h"
 #include "includes/cryptopp/filters.h"
@@ -146,61 +149,78 @@ std::string Crypto::Sign(std::string message, bool file /*=false*/, int encoding
 	}	
 }
 	
-bool Crypto::Verify(std::string message, std::string signature, std::string publicKey, bool file /*=false*/, int encoding /*=ENCODING_BASE64*/) {
-	bool result = false;
-
-	//Decode point
-	std::string hexKey = Util::string_to_hex(publicKey);
-	CryptoPP::HexDecoder decoder;
-	decoder.Put((byte*) hexKey.data(), hexKey.size());
-	decoder.MessageEnd();
-	size_t len = decoder.MaxRetrievable();
-	if(len%2) return false;
-
-	//Create point
-	CryptoPP::ECP::Point p;
-	p.identity = false;
-	p.x.Decode(decoder, len/2);
-	p.y.Decode(decoder, len/2);
+//Curve parameters are expensive to build, keep one copy of each per thread
+static const CryptoPP::DL_GroupParameters_EC<CryptoPP::ECP>* CurveParameters(size_t length) {
+	static thread_local CryptoPP::DL_GroupParameters_EC<CryptoPP::ECP> secp256r1(CryptoPP::ASN1::secp256r1());
+	static thread_local CryptoPP::DL_GroupParameters_EC<CryptoPP::ECP> secp384r1(CryptoPP::ASN1::secp384r1());
+	static thread_local CryptoPP::DL_GroupParameters_EC<CryptoPP::ECP> secp521r1(CryptoPP::ASN1::secp521r1());
 
-	//Initialize public key
-	CryptoPP::ECDSA<CryptoPP::ECP,CryptoPP::SHA256>::PublicKey pub;
-	switch(len) {
+	switch(length) {
 		//EC SECP256R1
-		case 64:
-			pub.Initialize(CryptoPP::ASN1::secp256r1(), p);
-			break;
-
+		case 64: return &secp256r1;
 		//EC SECP384R1
-		case 96:
-			pub.Initialize(CryptoPP::ASN1::secp384r1(), p);
-			break;
-
+		case 96: return &secp384r1;
 		//EC SECP521R1
-		case 132:
-			pub.Initialize(CryptoPP::ASN1::secp521r1(), p);
-			break;
-
+		case 132: return &secp521r1;
 		//Unsupported public key curve
-		default: return false;
+		default: return nullptr;
 	}
+}
 
-	CryptoPP::ECDSA<CryptoPP::ECP,CryptoPP::SHA256>::Verifier verifier(pub);
+//Same for verifiers, only the signer's point changes from one signature to the next
+static CryptoPP::ECDSA<CryptoPP::ECP,CryptoPP::SHA256>::Verifier* CurveVerifier(size_t length) {
+	static thread_local CryptoPP::ECDSA<CryptoPP::ECP,CryptoPP::SHA256>::Verifier verifiers[3];
+	static thread_local bool INITIALIZED[3] = {};
+
+	const CryptoPP::DL_GroupParameters_EC<CryptoPP::ECP> *parameters = CurveParameters(length);
+	if(!parameters) return nullptr;
 
-	std::string decodedSignature;
+	uint curve = length == 64 ? 0 : length == 96 ? 1 : 2;
+	if(!INITIALIZED[curve]) {
+		verifiers[curve].AccessKey().AccessGroupParameters() = *parameters;
+		INITIALIZED[curve] = true;
+	}
+	return &verifiers[curve];
+}
+
+static bool DecodePoint(const std::string &publicKey, CryptoPP::ECP::Point &p) {
+	//x and y, each as long as the curve's field
+	if(publicKey.size() % 2 || !CurveParameters(publicKey.size())) return false;
+
+	p.identity = false;
+	p.x.Decode((const byte*) publicKey.data(), publicKey.size()/2);
+	p.y.Decode((const byte*) publicKey.data() + publicKey.size()/2, publicKey.size()/2);
+	return true;
+}
+
+bool Crypto::DecodePublicKey(std::string publicKey, CryptoPP::ECDSA<CryptoPP::ECP,CryptoPP::SHA256>::PublicKey &pub) {
+	CryptoPP::ECP::Point p;
+	if(!DecodePoint(publicKey, p)) return false;
+
+	//Initialize public key
+	pub.Initialize(*CurveParameters(publicKey.size()), p);
+	return true;
+}
+
+static std::string DecodeSignature(const ByteViewStruct &signature, int encoding) {
 	switch(encoding) {
 		case ENCODING_HEX:
-			decodedSignature = Util::hex_to_string(signature);
-			break;
+			return Util::hex_to_string(signature.ToString());
 
 		case ENCODING_BASE64:
-			decodedSignature = Util::base64_to_string(signature);
-			break;
+			return Util::base64_to_string(signature.data, signature.length);
 
 		default:
-			decodedSignature = signature;
-			break;
+			return signature.ToString();
 	}
+}
+
+bool Crypto::Verify(std::string message, std::string signature, std::string publicKey, bool file /*=false*/, int encoding /*=ENCODING_BASE64*/) {
+	CryptoPP::ECDSA<CryptoPP::ECP,CryptoPP::SHA256>::PublicKey pub;
+	if(!DecodePublicKey(publicKey, pub)) return false;
+
+	CryptoPP::ECDSA<CryptoPP::ECP,CryptoPP::SHA256>::Verifier verifier(pub);
+	std::string decodedSignature = DecodeSignature({signature.data(), signature.size()}, encoding);
 
 	try{
 		if(file) {
@@ -211,16 +231,57 @@ bool Crypto::Verify(std::string message, std::string signature, std::string publ
 			message = hash;
 		}
 
-		CryptoPP::StringSource ss(message+decodedSignature, true, 
-			new CryptoPP::SignatureVerificationFilter(
-				verifier, 
-				new CryptoPP::ArraySink((byte*)&result, sizeof(result)),
-				CryptoPP::SignatureVerificationFilter::THROW_EXCEPTION | CryptoPP::SignatureVerificationFilter::PUT_RESULT
-		));
+		return verifier.VerifyMessage((const byte*) message.data(), message.size(), (const byte*) decodedSignature.data(), decodedSignature.size());
 	}
 	catch(CryptoPP::Exception& e) {
 		return false;
 	}
+}
+
+bool Crypto::VerifyBatch(std::vector<SignatureStruct> &batch, int encoding /*=ENCODING_BASE64*/) {
+	bool result = true;
+
+	//Group signatures by curve, each one's parameters and verifier are set up once for all its signers
+	std::map<size_t, std::vector<size_t>> curves;
+	for(size_t i = 0; i < batch.size(); i++) {
+		batch[i].valid = false;
+		curves[batch[i].publicKey.size()].push_back(i);
+	}
+
+	for(auto it = curves.begin(); it != curves.end(); ++it) {
+		CryptoPP::ECDSA<CryptoPP::ECP,CryptoPP::SHA256>::Verifier *verifier = CurveVerifier(it->first);
+		if(!verifier) {
+			result = false;
+			continue;
+		}
+
+		for(auto index = it->second.begin(); index != it->second.end(); ++index) {
+			SignatureStruct &item = batch[*index];
+			std::string decodedSignature = DecodeSignature(item.signature, encoding);
+
+			try{
+				//Hot keys keep the tables the keys cache precomputed for them
+				if(item.key && item.PRECOMPUTED) {
+					CryptoPP::ECDSA<CryptoPP::ECP,CryptoPP::SHA256>::Verifier hot(*item.key);
+					item.valid = hot.VerifyMessage((const byte*) item.message.data(), item.message.size(), (const byte*) decodedSignature.data(), decodedSignature.size());
+				}
+				else {
+					//a key already decoded by the keys cache saves decoding its point again
+					CryptoPP::ECP::Point point;
+					if(item.key) point = item.key->GetPublicElement();
+					else if(!DecodePoint(item.publicKey, point)) throw CryptoPP::Exception(CryptoPP::Exception::INVALID_DATA_FORMAT, "invalid public key");
+
+					//ECDSA verification already computes u1*G + u2*Q as a single cascaded multiplication
+					verifier->AccessKey().SetPublicElement(point);
+					item.valid = verifier->VerifyMessage((const byte*) item.message.data(), item.message.size(), (const byte*) decodedSignature.data(), decodedSignature.size());
+				}
+			}
+			catch(CryptoPP::Exception& e) {
+				item.valid = false;
+			}
+			result = result && item.valid;
+		}
+	}
 	return result;
 }
 
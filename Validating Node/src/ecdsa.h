@@ -38,16 +38,28 @@
 #ifndef ECDSA_H
 #define ECDSA_H
 
+#include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "includes/cryptopp/eccrypto.h"
 #include "includes/cryptopp/oids.h"
 #include "includes/cryptopp/sha.h"
 
+#include "byte_view.h"
 #include "globals.h"
 
 
+struct SignatureStruct {
+	std::string message;
+	ByteViewStruct signature; //read in place, its owner outlives the verification
+	std::string publicKey;
+	std::shared_ptr<const CryptoPP::ECDSA<CryptoPP::ECP,CryptoPP::SHA256>::PublicKey> key; //optional, already decoded publicKey
+	bool PRECOMPUTED = false; //key also holds verification tables of its own
+	bool valid;
+};
+
 namespace Crypto {
 
 	static std::mutex keyMutex;
@@ -59,6 +71,8 @@ namespace Crypto {
 
 	std::string Sign(std::string message, bool file=false, int encoding=ENCODING_BASE64);
 	bool Verify(std::string message, std::string signature, std::string publicKey, bool file=false, int encoding=ENCODING_BASE64);
+	bool VerifyBatch(std::vector<SignatureStruct> &batch, int encoding=ENCODING_BASE64);
+	bool DecodePublicKey(std::string publicKey, CryptoPP::ECDSA<CryptoPP::ECP,CryptoPP::SHA256>::PublicKey &pub);
 	
 	bool IsNIST(std::string key);
 	bool SolveYPoint(std::string xPoint, std::string &yPoint);
@@ -56,6 +56,11 @@ Entry::Entry(const char *rawEntry) {
 	entry.Parse(rawEntry);
 }
 
+Entry::Entry(rapidjson::Document &document) {
+	//take over an already parsed document
+	std::swap(entry, document);
+}
+
 bool Entry::IsEntry() {
 	//Ensure it is a valid JSON object and has the top-level keys
 	if(entry.IsObject() && entry.HasMember("resource") && entry.HasMember("data") && entry.HasMember("meta") && entry.HasMember("signer") && entry.HasMember("signature")){
@@ -47,6 +47,7 @@
 class Entry {
 	public:
 		Entry(const char rawEntry[]);
+		Entry(rapidjson::Document &document);
 		virtual ~Entry(){}
 
 		virtual bool IsEntry();
@@ -47,6 +47,7 @@ class AccountEntry : public Entry
 {
 	public:
 		AccountEntry(const char rawEntry[]) : Entry(rawEntry) {}
+		AccountEntry(rapidjson::Document &document) : Entry(document) {}
 
 		bool IsEntry();
 
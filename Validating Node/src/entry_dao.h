@@ -47,6 +47,7 @@ class DAOEntry : public Entry
 {
 	public:
 		DAOEntry(const char rawEntry[]) : Entry(rawEntry) {}
+		DAOEntry(rapidjson::Document &document) : Entry(document) {}
 
 		bool IsEntry();
 
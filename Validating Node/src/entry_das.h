@@ -47,6 +47,7 @@ class DASEntry : public Entry
 {
 	public:
 		DASEntry(const char rawEntry[]) : Entry(rawEntry) {}
+		DASEntry(rapidjson::Document &document) : Entry(document) {}
 
 		bool IsEntry();
 
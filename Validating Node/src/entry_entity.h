@@ -46,6 +46,7 @@
 class EntityEntry : public Entry {
 	public:
 		EntityEntry(const char rawEntry[]) : Entry(rawEntry) {}
+		EntityEntry(rapidjson::Document &document) : Entry(document) {}
 
 		bool IsEntry();
 
@@ -46,6 +46,7 @@
 class NodeEntry : public Entry {
 	public:
 		NodeEntry(const char rawEntry[]) : Entry(rawEntry) {}
+		NodeEntry(rapidjson::Document &document) : Entry(document) {}
 
 		bool IsEntry();
 
@@ -47,6 +47,7 @@ class PassportEntry : public Entry {
 	
 	public:
 		PassportEntry(const char rawEntry[]) : Entry(rawEntry) {}
+		PassportEntry(rapidjson::Document &document) : Entry(document) {}
 
 		bool IsEntry();
 
@@ -46,6 +46,7 @@
 class ResourceEntry : public Entry {
 	public:
 		ResourceEntry(const char rawEntry[]) : Entry(rawEntry) {}
+		ResourceEntry(rapidjson::Document &document) : Entry(document) {}
 
 		bool IsEntry();
 
@@ -47,6 +47,7 @@
 class SlotEntry : public Entry {
 	public:
 		SlotEntry(const char rawEntry[]) : Entry(rawEntry) {}
+		SlotEntry(rapidjson::Document &document) : Entry(document) {}
 
 		bool IsEntry();
 		bool CheckTimestamp();
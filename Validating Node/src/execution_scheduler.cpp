@@ -0,0 +1,194 @@
+/*
+	Copyright (c) 2016-2017, Unified Digital Currency
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+	WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/**
+ * @file execution_scheduler.cpp
+ * @author Rafael Afonso Rodrigues <founder@udc.world>
+ * @date 2016
+ * UDC Validating Node.
+ */
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "codes.h"
+#include "execution_scheduler.h"
+#include "globals.h"
+
+
+ExecutionScheduler::ExecutionScheduler(std::function<void(ExecutionStruct&)> execute, uint workers /*=0*/) : execute(execute) {
+	//the calling thread also executes groups, so it counts as one of the workers
+	if(!workers) workers = std::thread::hardware_concurrency();
+	for(uint i = 1; i < workers; i++) this->workers.push_back(std::thread(&ExecutionScheduler::Work, this));
+}
+
+ExecutionScheduler::~ExecutionScheduler() {
+	jobsMutex.lock();
+	IS_OPERATING = false;
+	jobsMutex.unlock();
+	jobsCondition.notify_all();
+
+	for(auto it = workers.begin(); it != workers.end(); ++it) it->join();
+}
+
+void ExecutionScheduler::Execute(std::vector<ExecutionStruct> &batch) {
+	std::vector<std::vector<size_t>> groups;
+	size_t begin = 0;
+	current = &batch;
+
+	for(size_t i = 0; i <= batch.size(); i++) {
+		if(i < batch.size() && !batch[i].exclusive) continue;
+
+		//Run everything queued before this point, independent groups concurrently
+		BuildGroups(batch, begin, i, groups);
+		RunGroups(groups);
+		groups.clear();
+
+		//Exclusive transactions act as barriers and are executed alone
+		if(i < batch.size() && batch[i].errorCode == VALID) execute(batch[i]);
+		begin = i + 1;
+	}
+}
+
+void ExecutionScheduler::BuildGroups(std::vector<ExecutionStruct> &batch, size_t begin, size_t end, std::vector<std::vector<size_t>> &groups) {
+	std::vector<size_t> parent(end - begin);
+	for(size_t i = 0; i < parent.size(); i++) parent[i] = i;
+
+	auto find = [&parent](size_t i) {
+		while(parent[i] != i) {
+			parent[i] = parent[parent[i]];
+			i = parent[i];
+		}
+		return i;
+	};
+	auto join = [&parent, &find](size_t a, size_t b) {
+		a = find(a);
+		b = find(b);
+		//the oldest transaction represents the group
+		if(a < b) parent[b] = a;
+		else if(b < a) parent[a] = b;
+	};
+
+	//Two transactions conflict when one debits an account the other debits or credits,
+	//credits alone commute and can be applied in any order
+	std::unordered_map<std::string, std::vector<size_t>> touched;
+	std::unordered_map<std::string, size_t> debited;
+
+	for(size_t i = 0; i < parent.size(); i++) {
+		ExecutionStruct &execution = batch[begin + i];
+		if(execution.errorCode != VALID) continue;
+
+		for(auto f = execution.senders.begin(); f != execution.senders.end(); ++f) {
+			auto &previous = touched[f->first];
+			for(auto it = previous.begin(); it != previous.end(); ++it) join(i, *it);
+			previous.assign(1, i);
+			debited[f->first] = i;
+		}
+
+		for(auto t = execution.receivers.begin(); t != execution.receivers.end(); ++t) {
+			auto it = debited.find(t->first);
+			if(it != debited.end()) join(i, it->second);
+			touched[t->first].push_back(i);
+		}
+	}
+
+	//Gather each group in submission order
+	std::unordered_map<size_t, size_t> index;
+	for(size_t i = 0; i < parent.size(); i++) {
+		if(batch[begin + i].errorCode != VALID) continue;
+
+		size_t root = find(i);
+		auto it = index.find(root);
+		if(it == index.end()) {
+			index[root] = groups.size();
+			groups.push_back(std::vector<size_t>(1, begin + i));
+		}
+		else groups[it->second].push_back(begin + i);
+	}
+}
+
+void ExecutionScheduler::RunGroups(std::vector<std::vector<size_t>> &groups) {
+	if(groups.empty()) return;
+
+	//Nothing to gain from handing a single group over
+	if(groups.size() == 1 || workers.empty()) {
+		for(auto it = groups.begin(); it != groups.end(); ++it) RunGroup(&(*it));
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(jobsMutex);
+	for(auto it = groups.begin(); it != groups.end(); ++it) jobs.push(&(*it));
+	remaining = groups.size();
+	jobsCondition.notify_all();
+
+	//help the workers instead of just waiting for them
+	while(!jobs.empty()) {
+		std::vector<size_t> *group = jobs.front();
+		jobs.pop();
+		lock.unlock();
+
+		RunGroup(group);
+
+		lock.lock();
+		remaining--;
+	}
+
+	doneCondition.wait(lock, [this]{ return remaining == 0; });
+}
+
+void ExecutionScheduler::RunGroup(std::vector<size_t> *group) {
+	for(auto it = group->begin(); it != group->end(); ++it) execute((*current)[*it]);
+}
+
+void ExecutionScheduler::Work() {
+	std::vector<size_t> *group;
+
+	while(true) {
+		std::unique_lock<std::mutex> lock(jobsMutex);
+		jobsCondition.wait(lock, [this]{ return !jobs.empty() || !IS_OPERATING; });
+		if(!IS_OPERATING) return;
+
+		group = jobs.front();
+		jobs.pop();
+		lock.unlock();
+
+		RunGroup(group);
+
+		lock.lock();
+		if(--remaining == 0) doneCondition.notify_all();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+/*
+	Copyright (c) 2016-2017, Unified Digital Currency
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+	WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/**
+ * @file execution_scheduler.h
+ * @author Rafael Afonso Rodrigues <founder@udc.world>
+ * @date 2016
+ * UDC Validating Node.
+ */
+
+#ifndef EXECUTION_SCHEDULER_H
+#define EXECUTION_SCHEDULER_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "globals.h"
+#include "hash160.h"
+
+class Transaction;
+
+
+struct ExecutionStruct {
+	Hash160 hash;
+	Transaction *transaction;
+	uint type;
+	int errorCode;
+	//must run alone, e.g. it touches DAO, DAS, Delayed or Future state
+	bool exclusive;
+
+	std::vector<std::pair<std::string, uint64_t>> senders;
+	std::vector<std::pair<std::string, uint64_t>> receivers;
+};
+
+//Applies a batch of transactions concurrently while keeping the outcome identical to applying them one by one
+class ExecutionScheduler {
+	public:
+		ExecutionScheduler(std::function<void(ExecutionStruct&)> execute, uint workers=0);
+		~ExecutionScheduler();
+
+		void Execute(std::vector<ExecutionStruct> &batch);
+
+	private:
+		std::function<void(ExecutionStruct&)> execute;
+		bool IS_OPERATING = true;
+		std::vector<std::thread> workers;
+
+		std::mutex jobsMutex;
+		std::condition_variable jobsCondition;
+		std::condition_variable doneCondition;
+		std::queue<std::vector<size_t>*> jobs;
+		std::vector<ExecutionStruct> *current;
+		uint remaining = 0;
+
+		void BuildGroups(std::vector<ExecutionStruct> &batch, size_t begin, size_t end, std::vector<std::vector<size_t>> &groups);
+		void RunGroups(std::vector<std::vector<size_t>> &groups);
+		void RunGroup(std::vector<size_t> *group);
+		void Work();
+};
+
+#endif
\ No newline at end of file
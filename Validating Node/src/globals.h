@@ -82,6 +82,7 @@ static const std::string WORLD_BANK_NODE_ACCOUNT 		= "UDC0000002";
 #define ITERATOR_NODE_END								"NODE4F000000" //ID following the last Validating Node ID
 
 #define STANDARD_HASH_LENGTH							40
+#define HASH160_LENGTH									20 //binary RIPEMD160 digest
 #define ACCOUNTS_HASH_LENGTH							STANDARD_HASH_LENGTH
 #define MERKLE_HASH_LENGTH								STANDARD_HASH_LENGTH
 #define LEDGER_HASH_LENGTH								STANDARD_HASH_LENGTH
@@ -95,6 +96,7 @@ static const std::string WORLD_BANK_NODE_ACCOUNT 		= "UDC0000002";
 #define NETWORK_SIGNATURE_LENGTH						1
 #define NETWORK_TRANSACTION_LENGTH						2
 #define NETWORK_ENTRY_LENGTH							2
+#define NETWORK_CONFIRMATIONS_LENGTH					2
 #define NETWORK_PUBLIC_KEY_LENGTH						1
 #define NETWORK_TIMESTAMP_LENGTH						10
 #define NETWORK_IP_LENGTH								15
@@ -117,6 +119,82 @@ static const std::string WORLD_BANK_NODE_ACCOUNT 		= "UDC0000002";
 #define TRANSACTION_HASH_LENGTH							STANDARD_HASH_LENGTH
 #define TRANSACTION_MAX_LENGTH							64000 // 64kB
 #define TRANSACTION_MIN_LENGTH							13 // {"type":"XX"}
+#define TRANSACTIONS_SHARDS								16 //mempool partitions, each with its own lock
+#define TRANSACTION_QUEUE_CAPACITY						65536 //pending transactions awaiting processing
+#define TRANSACTION_QUEUE_WAIT							100 //ms the processing thread stays parked before rechecking
+#define ADMISSION_RATE									20000 //transactions/s accepted from all managing entities
+#define ADMISSION_BURST									40000
+#define ADMISSION_ENTITY_RATE							4000 //transactions/s accepted from a single managing entity
+#define ADMISSION_ENTITY_BURST							8000
+#define ADMISSION_IN_FLIGHT								16384 //entity submissions awaiting their validation reply
+#define ADMISSION_ENTITY_IN_FLIGHT						4096
+#define ADMISSION_QUEUE_LIMIT							(TRANSACTION_QUEUE_CAPACITY/2) //keeps room in the queue for peer nodes' transactions
+#define SEEN_FILTER_BITS								16777216 //bits per generation, 2MB
+#define SEEN_FILTER_HASHES								4 //probes per hash
+#define SEEN_FILTER_GENERATIONS							3 //current, previous and the one being cleared
+#define SEEN_FILTER_INTERVAL							LEDGER_CLOSING_INTERVAL //lifetime of a generation, in nanos
+#define STAGE_RECEIVED									0 //its histogram holds the end-to-end latency, up to registration
+#define STAGE_PARSED									1
+#define STAGE_VERIFIED									2
+#define STAGE_EXECUTED									3
+#define STAGE_BROADCAST									4 //recorded once the confirmations batch is sent, not stamped on the transaction
+#define STAGE_CONFIRMED									5 //since execution, its confirmations batch may be sent after the transaction is let go
+#define STAGE_PUBLISHED									6
+#define STAGE_REGISTERED								7
+#define TRANSACTION_STAGES								8
+#define STATS_SUB_BUCKETS								16 //per power of two, ~6% precision
+#define STATS_BUCKETS									976 //covers the whole uint64_t nanoseconds range
+#define STATS_PORT										4201 //local only, replies with the current statistics
+#define TRANSACTION_VERIFICATION_WINDOW					4096 //transactions being verified ahead of processing
+#define DEFAULT_VERIFICATION_WORKERS					0 //0 uses one per available core
+#define TRANSACTION_EXECUTION_BATCH						256 //verified transactions scheduled together
+#define TRANSACTION_ARENA_CHUNK							16384 //JSON memory pool growth step
+#ifndef TRANSACTION_ARENA_SIZE
+#define TRANSACTION_ARENA_SIZE							262144 //pool size after which a thread starts a new one, 0 gives each transaction its own
+#endif
+#define TRANSACTION_ARENA_MIN_CHUNK						1024 //smallest pool of a transaction kept in an arena of its own
+#define TRANSACTION_FIELDS								4 //sender, outbound and inbound signatures, then a reference
+#define SIGNATURE_SENDER								0
+#define SIGNATURE_OUTBOUND								1
+#define SIGNATURE_INBOUND								2
+#define FIELD_REFERENCE									3 //request, future or slot
+#define DEFAULT_EXECUTION_WORKERS						0 //0 uses one per available core
+#define KEYS_CACHE_CAPACITY								16384 //decoded public keys kept in memory
+#define KEYS_CACHE_PRECOMPUTE_THRESHOLD					32 //verifications before a key gets precomputed tables
+#define KEYS_LOCK_STRIPES								64 //id lock stripes, serializing a key's fetch with its update
+#define KEYS_PRECOMPUTE_STORAGE							16 //precomputed multiples per hot key
+#define BALANCES_SHARDS									64 //account lock stripes, each also holding its part of the balance cache
+#define BALANCES_CACHE_CAPACITY							1048576 //accounts kept in memory before clean ones are evicted
+#define BALANCES_FLUSH_INTERVAL							1000000000 //1s, in nanos
+#define BALANCES_FORMAT_VERSION							2 //little-endian 8 bytes values, 1 being decimal strings
+#define BALANCES_MIGRATION_BATCH						10000 //balances converted between resume points
+#define BALANCES_CHECKPOINTS							3 //ledger boundaries whose balances can be restored
+#define DATABASE_PROFILE_NETWORK_MANAGEMENT				0 //prefix lookups by NMDB masks
+#define DATABASE_PROFILE_BALANCES						1 //hot point reads and merges
+#define DATABASE_PROFILE_KEYS							2 //hot point reads, rare writes
+#define DATABASE_PROFILE_SLOTS							3 //small, fixed cardinality
+#define DATABASE_FAMILIES								4 //one column family per profile
+#define DATABASE_IMPORT_BATCH							10000 //entries copied at once from a standalone database
+#define DEFAULT_DATABASE_CACHE_BUDGET					512 //MB shared by all databases' block caches and memtables
+#define DEFAULT_DATABASE_WRITE_BUFFER					64 //MB per memtable of the write heavy databases
+#define DEFAULT_DATABASE_BLOOM_BITS						10 //bloom filter bits per key, ~1% false positives
+#define TIMER_WHEEL_RESOLUTION							10000000 //10ms ticks, in nanos
+#define TIMER_WHEEL_BITS								8
+#define TIMER_WHEEL_SLOTS								256 //slots per level, 1 << TIMER_WHEEL_BITS
+#define TIMER_WHEEL_LEVELS								4 //covers 2^32 ticks, further deadlines are cascaded again
+#define TIMER_WHEEL_IDLE_WAIT							100 //ms the registration thread stays parked when nothing is scheduled
+#define TIMER_REGISTRATION								0
+#define TIMER_DELAYED_EXPIRATION						1
+#define TIMER_FUTURE_EXPIRATION							2
+#define TIMER_CONFIRMATION_EXPIRATION					3
+#define TIMER_TYPES										4
+#define HOLD_PROCESSING									0x01 //reasons a transaction is kept in memory
+#define HOLD_CONFIRMATION								0x02
+#define HOLD_REGISTRATION								0x04
+#define HOLD_DELAYED									0x08
+#define HOLD_FUTURE										0x10
+#define HOLD_MODULE										0x20
+#define HOLD_ALL										0x3F
 
 #define NETWORK_QUORUM_RATIO							0.4
 #define TRANSACTION_BROADCAST_RATIO						0.8
@@ -142,6 +220,8 @@ static const std::string WORLD_BANK_NODE_ACCOUNT 		= "UDC0000002";
 #define DEFAULT_NODE_PORT								4200
 #define NODE_MAX_RETRIES								5
 #define NODE_KEEP_ALIVE_INTERVAL						60
+#define NODE_CONFIRMATIONS_BATCH						256 //hashes per batched confirmation frame
+#define NODE_CONFIRMATIONS_INTERVAL						5 //ms a pending confirmation waits before the batch is flushed
 
 #define STANDARD_ID_LENGTH								8
 #define NODE_ID_LENGTH									STANDARD_ID_LENGTH
@@ -176,8 +256,7 @@ static const std::string BLOCK_ENTRIES_EXTENSION 		= ".ents";
 
 #define PUBLISHER_SUBSCRIPTIONS_LENGTH 					40	
 
-#define KEYS_BACKUP_INTERVAL							5400 //1h30
-#define NETWORK_BACKUP_INTERVAL							7200 //2h
+#define NETWORK_BACKUP_INTERVAL							5400 //1h30, the node database along with every store in it
 #define PUBLISHER_BACKUP_INTERVAL						3600 //1h
 #define SLOTS_BACKUP_INTERVAL							3600 //1h
 
@@ -232,12 +311,16 @@ static const std::string LOCAL_TEMP_DATA				= LOCAL_DATA+"temp/";
 static const std::string LOCAL_DATA_MODULES				= LOCAL_DATA+"modules/";
 
 //databases locations
+static const std::string DATABASE_NODE					= LOCAL_DATA_DATABASES+"node";
+static const std::string DATABASE_NODE_BACKUP				= LOCAL_DATA_DATABASES+"node_backup";
 static const std::string DATABASE_PUBLIC_KEYS				= LOCAL_DATA_DATABASES+"public_keys";
-static const std::string DATABASE_PUBLIC_KEYS_BACKUP		= LOCAL_DATA_DATABASES+"public_keys_backup";
 static const std::string DATABASE_SLOTS						= LOCAL_DATA_DATABASES+"account_slots";
 static const std::string DATABASE_BALANCES					= LOCAL_DATA_DATABASES+"account_balances";
+static const std::string BALANCES_JOURNAL_KEY			= "balances_journal"; //operations journals position covered by the stored balances
+static const std::string BALANCES_VERSION_KEY			= "balances_version"; //format of the stored balances
+static const std::string BALANCES_MIGRATION_KEY			= "balances_migration"; //last balance converted by an interrupted migration
+static const std::string BALANCES_CHECKPOINT_KEY		= "balances_checkpoint_"; //followed by the ledger id, its net movements
 static const std::string DATABASE_NETWORK_MANAGEMENT		= LOCAL_DATA_DATABASES+"network_management";
-static const std::string DATABASE_NETWORK_MANAGEMENT_BACKUP	= LOCAL_DATA_DATABASES+"network_management_backup";
 
 
 
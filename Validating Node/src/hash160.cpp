@@ -0,0 +1,106 @@
+/*
+	Copyright (c) 2016-2017, Unified Digital Currency
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+	WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/**
+ * @file hash160.cpp
+ * @author Rafael Afonso Rodrigues <founder@udc.world>
+ * @date 2016
+ * UDC Validating Node.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "globals.h"
+#include "hash160.h"
+
+
+static int HexValue(char c) {
+	if(c >= '0' && c <= '9') return c - '0';
+	if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+	if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+	return -1;
+}
+
+Hash160::Hash160() {
+	memset(bytes, 0, HASH160_LENGTH);
+}
+
+bool Hash160::FromHex(const std::string &hex, Hash160 &hash) {
+	if(hex.size() != 2*HASH160_LENGTH) return false;
+
+	for(uint i = 0; i < HASH160_LENGTH; i++) {
+		int high = HexValue(hex[2*i]), low = HexValue(hex[2*i+1]);
+		if(high < 0 || low < 0) return false;
+		hash.bytes[i] = (high << 4) | low;
+	}
+	return true;
+}
+
+Hash160 Hash160::FromDigest(const std::string &digest) {
+	Hash160 hash;
+	if(digest.size() == HASH160_LENGTH) memcpy(hash.bytes, digest.data(), HASH160_LENGTH);
+	return hash;
+}
+
+void Hash160::SortUnique(std::vector<Hash160> &list) {
+	//byte order is the same as the order of their uppercase hex forms
+	std::sort(list.begin(), list.end());
+	list.erase(std::unique(list.begin(), list.end()), list.end());
+}
+
+bool Hash160::Insert(std::vector<Hash160> &list, const Hash160 &hash) {
+	auto it = std::lower_bound(list.begin(), list.end(), hash);
+	if(it != list.end() && *it == hash) return false;
+	list.insert(it, hash);
+	return true;
+}
+
+bool Hash160::Contains(const std::vector<Hash160> &list, const Hash160 &hash) {
+	return std::binary_search(list.begin(), list.end(), hash);
+}
+
+std::string Hash160::ToHex() const {
+	static const char digits[] = "0123456789ABCDEF";
+	std::string hex(2*HASH160_LENGTH, '0');
+
+	for(uint i = 0; i < HASH160_LENGTH; i++) {
+		hex[2*i] = digits[bytes[i] >> 4];
+		hex[2*i+1] = digits[bytes[i] & 0x0F];
+	}
+	return hex;
+}
+
+bool Hash160::IsNull() const {
+	for(uint i = 0; i < HASH160_LENGTH; i++) if(bytes[i]) return false;
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+/*
+	Copyright (c) 2016-2017, Unified Digital Currency
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+	WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/**
+ * @file hash160.h
+ * @author Rafael Afonso Rodrigues <founder@udc.world>
+ * @date 2016
+ * UDC Validating Node.
+ */
+
+#ifndef HASH160_H
+#define HASH160_H
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "globals.h"
+
+
+//Binary RIPEMD160 hash of transactions, entries, ledgers and blocks, only turned into hex for JSON and humans
+class Hash160 {
+	public:
+		Hash160();
+
+		static bool FromHex(const std::string &hex, Hash160 &hash);
+		static Hash160 FromDigest(const std::string &digest);
+		static void SortUnique(std::vector<Hash160> &list);
+		static bool Insert(std::vector<Hash160> &list, const Hash160 &hash);
+		static bool Contains(const std::vector<Hash160> &list, const Hash160 &hash);
+
+		std::string ToHex() const;
+		bool IsNull() const;
+
+		bool operator==(const Hash160 &other) const { return memcmp(bytes, other.bytes, HASH160_LENGTH) == 0; }
+		bool operator!=(const Hash160 &other) const { return memcmp(bytes, other.bytes, HASH160_LENGTH) != 0; }
+		bool operator<(const Hash160 &other) const { return memcmp(bytes, other.bytes, HASH160_LENGTH) < 0; }
+
+		unsigned char bytes[HASH160_LENGTH];
+};
+
+namespace std {
+	template<> struct hash<Hash160> {
+		//already uniformly distributed, the leading bytes are enough
+		size_t operator()(const Hash160 &hash) const {
+			size_t value;
+			memcpy(&value, hash.bytes, sizeof(value));
+			return value;
+		}
+	};
+}
+
+#endif
\ No newline at end of file
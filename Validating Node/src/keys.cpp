@@ -35,24 +35,32 @@
  * UDC Validating Node.
  */
 
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <set>
 #include <string>
+#include <vector>
 
 #include "includes/boost/regex.hpp"
 #include "includes/rocksdb/db.h"
-#include "includes/rocksdb/utilities/backupable_db.h"
 
 #include "codes.h"
 #include "ecdsa.h"
 #include "entity.h"
 #include "globals.h"
 #include "keys.h"
+#include "keys_cache.h"
 #include "node.h"
 #include "slots.h"
 #include "util.h"
 
 
-Keys::Keys(rocksdb::DB* keysDB)	: db(keysDB) {}
+Keys::Keys(rocksdb::DB* keysDB, rocksdb::ColumnFamilyHandle *family)	: db(keysDB), family(family) {}
+
+std::mutex& Keys::Stripe(const std::string &id) {
+	return stripes[std::hash<std::string>()(id) % KEYS_LOCK_STRIPES];
+}
 
 void Keys::SetReferences(Entities *entities, Nodes *nodes, Slots* slotsDB) {
 	this->entities = entities;
@@ -61,26 +69,22 @@ void Keys::SetReferences(Entities *entities, Nodes *nodes, Slots* slotsDB) {
 	HAS_REFERENCES = true;
 }
 
-bool Keys::BackupData() {
-	rocksdb::BackupEngine* backup_engine;
-
-	std::lock_guard<std::mutex> lock(dbMutex);
-    rocksdb::Status status = rocksdb::BackupEngine::Open(rocksdb::Env::Default(), rocksdb::BackupableDBOptions(DATABASE_PUBLIC_KEYS_BACKUP), &backup_engine);
-
-    if(status.ok()) {
-    	backup_engine->CreateNewBackup(db);
-    	delete backup_engine;
-    	return true;
-    }
-
-    return false;
-}
-
 bool Keys::GetPublicKey(std::string id, std::string &publicKey, int idType /*=ID_TYPE_ACCOUNT*/, bool request /*=true*/) {
-	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), id, &publicKey);
+	std::shared_ptr<const CryptoPP::ECDSA<CryptoPP::ECP,CryptoPP::SHA256>::PublicKey> decoded;
 	std::string entity;
 
+	//check the cache first
+	if(cache.Get(id, publicKey, decoded)) return true;
+
+	//misses are serialized with updates of the same id only, so an outdated key is never cached
+	std::unique_lock<std::mutex> lock(Stripe(id));
+	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), family, id, &publicKey);
+
 	//return if key was found
+	if(status.ok()) {
+		cache.Set(id, publicKey);
+		return true;
+	}
 	if(!status.IsNotFound()) return true;
 
 	//otherwise, try to retrieve it from another source
@@ -88,6 +92,7 @@ bool Keys::GetPublicKey(std::string id, std::string &publicKey, int idType /*=ID
 		switch(idType) {
 			case ID_TYPE_ACCOUNT:
 				//find the managing entity and send a request for the public key
+				lock.unlock();
 				if(slotsDB->GetEntity(id, entity)) entities->PublicKeyRequest(entity, id);
 				return false;
 
@@ -101,13 +106,44 @@ bool Keys::GetPublicKey(std::string id, std::string &publicKey, int idType /*=ID
 		}
 
 		//save it
-		db->Put(rocksdb::WriteOptions(), id, publicKey);
+		db->Put(rocksdb::WriteOptions(), family, id, publicKey);
+		cache.Set(id, publicKey);
 		return true;
 	}
 	return false;
 }
 
 bool Keys::SetPublicKey(std::string id, std::string publicKey, int idType /*=ID_TYPE_ACCOUNT*/) {
+	if(!DecodePublicKey(id, publicKey, idType)) return false;
+
+	std::lock_guard<std::mutex> lock(Stripe(id));
+	//insert into database
+	rocksdb::Status status = db->Put(rocksdb::WriteOptions(), family, id, publicKey);
+	if(!status.ok()) {
+		cache.Invalidate(id);
+		return false;
+	}
+
+	//keep the cache in line with the database
+	cache.Set(id, publicKey);
+	return true;
+}
+
+bool Keys::SetPublicKey(rocksdb::WriteBatch &batch, std::string id, std::string publicKey, std::string &stored, int idType /*=ID_TYPE_ACCOUNT*/) {
+	if(!DecodePublicKey(id, publicKey, idType)) return false;
+
+	batch.Put(family, id, publicKey);
+	stored = publicKey;
+	return true;
+}
+
+void Keys::Invalidate(std::string id) {
+	//a lookup started before the batch was written can't cache the previous key after this
+	std::lock_guard<std::mutex> lock(Stripe(id));
+	cache.Invalidate(id);
+}
+
+bool Keys::DecodePublicKey(std::string id, std::string &publicKey, int idType) {
 	boost::regex keyRegex(PATTERN_BASE64);
 	boost::regex idRegex;
 	std::string yPoint;
@@ -164,12 +200,7 @@ bool Keys::SetPublicKey(std::string id, std::string publicKey, int idType /*=ID_
 
 			default: return false;
 	}
-	if(!boost::regex_match(id, idRegex)) return false;
-
-	std::lock_guard<std::mutex> lock(dbMutex);
-	//insert into database
-	rocksdb::Status status = db->Put(rocksdb::WriteOptions(), id, publicKey);
-	return status.ok();
+	return boost::regex_match(id, idRegex);
 }
 
 bool Keys::GetManagingEntityKey(std::string account, std::string &publicKey) {
@@ -179,4 +210,46 @@ bool Keys::GetManagingEntityKey(std::string account, std::string &publicKey) {
 	if(!slotsDB->GetEntity(account, entity)) return false;
 	
 	return GetPublicKey(entity, publicKey, ID_TYPE_ENTITY);
+}
+
+bool Keys::GetPublicKey(std::string id, SignatureStruct &signature, int idType /*=ID_TYPE_ACCOUNT*/) {
+	if(cache.Get(id, signature.publicKey, signature.key, &signature.PRECOMPUTED)) return true;
+	if(!GetPublicKey(id, signature.publicKey, idType)) return false;
+
+	//the key was cached while being fetched
+	cache.Get(id, signature.publicKey, signature.key, &signature.PRECOMPUTED);
+	return true;
+}
+
+void Keys::Prefetch(const std::vector<std::string> &ids) {
+	std::set<std::string> missing;
+	std::set<uint> indexes;
+
+	for(auto id = ids.begin(); id != ids.end(); ++id) {
+		if(id->empty() || cache.Contains(*id)) continue;
+		missing.insert(*id);
+		indexes.insert(std::hash<std::string>()(*id) % KEYS_LOCK_STRIPES);
+	}
+	if(missing.empty()) return;
+
+	//same rule as single misses, ascending order so prefetches can't deadlock each other
+	std::vector<std::unique_lock<std::mutex>> locks;
+	for(auto index = indexes.begin(); index != indexes.end(); ++index) locks.emplace_back(stripes[*index]);
+
+	std::vector<rocksdb::Slice> keys(missing.begin(), missing.end());
+	std::vector<std::string> values;
+	std::vector<rocksdb::Status> statuses = db->MultiGet(rocksdb::ReadOptions(), std::vector<rocksdb::ColumnFamilyHandle*>(keys.size(), family), keys, &values);
+
+	//absent keys are left for GetPublicKey to request
+	for(size_t i = 0; i < statuses.size(); i++) {
+		if(statuses[i].ok()) cache.Set(keys[i].ToString(), values[i]);
+	}
+}
+
+bool Keys::GetManagingEntityKey(std::string account, SignatureStruct &signature) {
+	std::string entity;
+
+	if(!slotsDB->GetEntity(account, entity)) return false;
+
+	return GetPublicKey(entity, signature, ID_TYPE_ENTITY);
 }
\ No newline at end of file
@@ -40,35 +40,54 @@
 
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "includes/rocksdb/db.h"
+#include "includes/rocksdb/write_batch.h"
 
 #include "codes.h"
+#include "globals.h"
+#include "keys_cache.h"
 
 class Entities;
 class Nodes;
 class Slots;
+struct SignatureStruct;
 
 
 class Keys {
 	public:
-		Keys(rocksdb::DB *keysDB);
+		Keys(rocksdb::DB *keysDB, rocksdb::ColumnFamilyHandle *family);
 
 		void SetReferences(Entities *entities, Nodes *nodes, Slots* slotsDB);
-		bool BackupData();
 
 		bool GetPublicKey(std::string id, std::string &publicKey, int idType=ID_TYPE_ACCOUNT, bool request=true);
 		bool SetPublicKey(std::string id, std::string publicKey, int idType=ID_TYPE_ACCOUNT);
+		//Same as above, written along with the caller's batch, which then calls Invalidate once it's committed
+		bool SetPublicKey(rocksdb::WriteBatch &batch, std::string id, std::string publicKey, std::string &stored, int idType=ID_TYPE_ACCOUNT);
+		void Invalidate(std::string id);
 		bool GetManagingEntityKey(std::string account, std::string &key);
 
+		//Same as above, also providing the decoded key for verification
+		bool GetPublicKey(std::string id, SignatureStruct &signature, int idType=ID_TYPE_ACCOUNT);
+		bool GetManagingEntityKey(std::string account, SignatureStruct &signature);
+
+		//Brings the uncached keys in with a single lookup
+		void Prefetch(const std::vector<std::string> &ids);
+
 	private:
-		std::mutex dbMutex;
+		std::mutex stripes[KEYS_LOCK_STRIPES];
 		rocksdb::DB *db;
+		rocksdb::ColumnFamilyHandle *family;
+		KeysCache cache;
 		
 		Entities *entities;
 		Nodes *nodes;
 		Slots *slotsDB;
 		bool HAS_REFERENCES = false;
+
+		std::mutex& Stripe(const std::string &id);
+		bool DecodePublicKey(std::string id, std::string &publicKey, int idType);
 };
 
 #endif
\ No newline at end of file
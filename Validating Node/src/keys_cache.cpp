@@ -0,0 +1,145 @@
+/*
+	Copyright (c) 2016-2017, Unified Digital Currency
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+	WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/**
+ * @file keys_cache.cpp
+ * @author Rafael Afonso Rodrigues <founder@udc.world>
+ * @date 2016
+ * UDC Validating Node.
+ */
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "includes/cryptopp/eccrypto.h"
+#include "includes/cryptopp/sha.h"
+
+#include "ecdsa.h"
+#include "globals.h"
+#include "keys_cache.h"
+
+
+KeysCache::KeysCache(uint capacity /*=KEYS_CACHE_CAPACITY*/) : capacity(capacity ? capacity : 1) {
+	keys.reserve(this->capacity);
+}
+
+bool KeysCache::Get(std::string id, std::string &publicKey, std::shared_ptr<const CryptoPP::ECDSA<CryptoPP::ECP,CryptoPP::SHA256>::PublicKey> &decoded, bool *TABLES /*=nullptr*/) {
+	std::unique_lock<std::mutex> lock(cacheMutex);
+	auto it = keys.find(id);
+	if(it == keys.end()) return false;
+
+	//Mark as most recently used
+	recent.splice(recent.begin(), recent, it->second.position);
+	publicKey = it->second.publicKey;
+	decoded = it->second.decoded;
+	if(TABLES) *TABLES = it->second.TABLES;
+
+	//Once a key proves to be hot, build its tables outside the lock
+	if(++it->second.uses >= KEYS_CACHE_PRECOMPUTE_THRESHOLD && !it->second.PRECOMPUTED) {
+		it->second.PRECOMPUTED = true;
+		lock.unlock();
+		Precompute(id, publicKey, decoded);
+	}
+	return true;
+}
+
+void KeysCache::Set(std::string id, std::string publicKey) {
+	//Decode before taking the lock
+	std::shared_ptr<CryptoPP::ECDSA<CryptoPP::ECP,CryptoPP::SHA256>::PublicKey> decoded = std::make_shared<CryptoPP::ECDSA<CryptoPP::ECP,CryptoPP::SHA256>::PublicKey>();
+	if(!Crypto::DecodePublicKey(publicKey, *decoded)) {
+		Invalidate(id);
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	auto it = keys.find(id);
+
+	//Replace an existing key
+	if(it != keys.end()) {
+		recent.splice(recent.begin(), recent, it->second.position);
+		it->second.publicKey = publicKey;
+		it->second.decoded = decoded;
+		it->second.uses = 0;
+		it->second.PRECOMPUTED = false;
+		it->second.TABLES = false;
+		return;
+	}
+
+	recent.push_front(id);
+	keys[id] = {publicKey, decoded, 0, false, false, recent.begin()};
+
+	//Evict the least recently used key
+	if(keys.size() > capacity) {
+		keys.erase(recent.back());
+		recent.pop_back();
+	}
+}
+
+void KeysCache::Invalidate(std::string id) {
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	auto it = keys.find(id);
+	if(it == keys.end()) return;
+
+	recent.erase(it->second.position);
+	keys.erase(it);
+}
+
+bool KeysCache::Contains(std::string id) {
+	//doesn't count as a use
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	return keys.find(id) != keys.end();
+}
+
+size_t KeysCache::Size() {
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	return keys.size();
+}
+
+void KeysCache::Precompute(std::string id, std::string publicKey, std::shared_ptr<const CryptoPP::ECDSA<CryptoPP::ECP,CryptoPP::SHA256>::PublicKey> decoded) {
+	std::shared_ptr<CryptoPP::ECDSA<CryptoPP::ECP,CryptoPP::SHA256>::PublicKey> precomputed = std::make_shared<CryptoPP::ECDSA<CryptoPP::ECP,CryptoPP::SHA256>::PublicKey>(*decoded);
+
+	try{
+		precomputed->Precompute(KEYS_PRECOMPUTE_STORAGE);
+	}
+	catch(CryptoPP::Exception& e) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	auto it = keys.find(id);
+
+	//The key may have been replaced or evicted meanwhile
+	if(it == keys.end() || it->second.publicKey != publicKey) return;
+	it->second.decoded = precomputed;
+	it->second.TABLES = true;
+}
\ No newline at end of file
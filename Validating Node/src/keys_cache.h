@@ -0,0 +1,84 @@
+/*
+	Copyright (c) 2016-2017, Unified Digital Currency
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+	WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/**
+ * @file keys_cache.h
+ * @author Rafael Afonso Rodrigues <founder@udc.world>
+ * @date 2016
+ * UDC Validating Node.
+ */
+
+#ifndef KEYS_CACHE_H
+#define KEYS_CACHE_H
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "includes/cryptopp/eccrypto.h"
+#include "includes/cryptopp/sha.h"
+
+#include "globals.h"
+
+
+//Least recently used cache of decoded public keys, frequently used keys get precomputed verification tables
+class KeysCache {
+	public:
+		KeysCache(uint capacity=KEYS_CACHE_CAPACITY);
+		~KeysCache(){}
+
+		bool Get(std::string id, std::string &publicKey, std::shared_ptr<const CryptoPP::ECDSA<CryptoPP::ECP,CryptoPP::SHA256>::PublicKey> &decoded, bool *TABLES=nullptr);
+		void Set(std::string id, std::string publicKey);
+		void Invalidate(std::string id);
+		bool Contains(std::string id);
+
+		size_t Size();
+
+	private:
+		struct CachedKeyStruct {
+			std::string publicKey;
+			std::shared_ptr<const CryptoPP::ECDSA<CryptoPP::ECP,CryptoPP::SHA256>::PublicKey> decoded;
+			uint64_t uses;
+			bool PRECOMPUTED; //tables requested
+			bool TABLES; //decoded already holds them
+			std::list<std::string>::iterator position;
+		};
+
+		void Precompute(std::string id, std::string publicKey, std::shared_ptr<const CryptoPP::ECDSA<CryptoPP::ECP,CryptoPP::SHA256>::PublicKey> decoded);
+
+		std::mutex cacheMutex;
+		std::unordered_map<std::string, CachedKeyStruct> keys;
+		std::list<std::string> recent; //most recently used first
+		uint capacity;
+};
+
+#endif
\ No newline at end of file
@@ -37,6 +37,7 @@
 
 #include <mutex>
 #include <fstream>
+#include <initializer_list>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -54,6 +55,7 @@
 #include "configurations.h"
 #include "globals.h"
 #include "transaction.h"
+#include "hash160.h"
 #include "ledger.h"
 #include "merkle.h"
 #include "network.h"
@@ -190,7 +192,7 @@ void Ledger::RegisterTransaction(Transaction *Tx) {
 	ledgerPtr->feesCollected += Tx->GetFees();
 
 	//inserts the transaction
-	ledgerPtr->transactionsList.insert(Tx->GetHash());
+	ledgerPtr->transactionsList.push_back(Tx->GetDigest());
 	std::string transaction = "\"" + Tx->GetHash() + "\":" + Tx->GetTransaction();
 	ledgerPtr->transactionsData << "," << transaction;
 	ledgerPtr->transactionsData.flush();
@@ -200,8 +202,20 @@ void Ledger::RegisterTransaction(Transaction *Tx) {
 	// while(!publisher->PublishTransaction("{"+transaction+"}") && counter < 3) counter++;
 }
 
-void Ledger::CloseLedger() {
+std::string Ledger::JournalPosition() {
+	std::lock_guard<std::mutex> lock(dataMutex);
+
+	//operations are flushed as soon as they are registered
+	std::string position;
+	for(LedgerStruct *ledger: {&currentLedger, &nextLedger}) {
+		boost::filesystem::path file(ledger->operationsFile);
+		if(ledger->operationsFile.empty() || !boost::filesystem::exists(file)) continue;
+		position += ledger->operationsFile + " " + std::to_string(boost::filesystem::file_size(file)) + " ";
+	}
+	return position;
+}
 
+void Ledger::CloseLedger() {
 	if(IS_SYNCHRONIZED) {
 		dataMutex.lock();
 		//close data streams of the current ledger
@@ -246,6 +260,9 @@ void Ledger::CloseLedger() {
 	nextLedger.transactionsData.open(nextLedger.transactionsFile, std::fstream::out | std::fstream::trunc);
 	nextLedger.operationsData.open(nextLedger.operationsFile, std::fstream::out | std::fstream::trunc);
 
+	//Nothing else is journaled into the closed ledger, let the processing thread persist the balances
+	balancesDB->RequestFlush();
+
 	IS_SYNCHRONIZED = true;
 }
 
@@ -259,6 +276,7 @@ void Ledger::BuildLedger() {
 	CryptoPP::FileSource fs(currentLedger.accountsFile.c_str(), true, new CryptoPP::HashFilter(ripemd, new CryptoPP::HexEncoder(new CryptoPP::StringSink(accountsHash))));
 
 	//calculate the root of the transactions' Merkle tree
+	Hash160::SortUnique(currentLedger.transactionsList);
 	transactionsRoot = Crypto::MerkleRoot(currentLedger.transactionsList);
 
 	//Compute Ledger's hash
@@ -345,14 +363,19 @@ void Ledger::CalculateBalances() {
 	previousLedger.close();
 
 	//update balances by computing the movements occurred during the new ledger
+	std::unordered_map<std::string,uint64_t> movements;
 	currentLedger.operationsData.open(currentLedger.operationsFile, std::fstream::in);
 
 	while(currentLedger.operationsData >> account >> operation >> amount) {
-		if(operation == "+") accountsList[account] += amount;
-		else accountsList[account] -= amount;
+		uint64_t movement = operation == "+" ? amount : -amount;
+		accountsList[account] += movement;
+		movements[account] += movement;
 	}
 	currentLedger.operationsData.close();
 
+	//the ledger's boundary, so it can be taken out of the balances if the network closed it differently
+	balancesDB->Checkpoint(currentLedger.ledgerId, movements);
+
 	//ignores worldbank account
 	accountsList.erase(WORLD_BANK_ACCOUNT);
 
@@ -468,7 +491,7 @@ bool Ledger::SetLedger(std::string tempLedger) {
 
 	//forward to the transactions and retrieve all hashes
 	in.seekg(16, std::ios_base::cur);
-	std::set<std::string> transactionsList;
+	std::vector<Hash160> transactionsList;
 
 	int count;
 	bool outside;
@@ -478,7 +501,12 @@ bool Ledger::SetLedger(std::string tempLedger) {
 		//get hash
 		in.read(&buffer.front(), TRANSACTION_HASH_LENGTH);
 		value = Util::array_to_string(buffer, TRANSACTION_HASH_LENGTH, 0);
-		transactionsList.insert(value);
+		transactionsList.emplace_back();
+		if(!Hash160::FromHex(value, transactionsList.back())) {
+			in.close();
+			FailedToFetch(hash);
+			return false;
+		}
 		in.seekg(3, std::ios_base::cur);
 
 		//skip its contents
@@ -499,6 +527,7 @@ bool Ledger::SetLedger(std::string tempLedger) {
 	in.close();
 
 	//verify the Merkle tree root is correct
+	Hash160::SortUnique(transactionsList);
 	if(transactionsRoot != Crypto::MerkleRoot(transactionsList)) {
 		FailedToFetch(hash);
 		return false;
@@ -520,7 +549,7 @@ bool Ledger::SetLedger(std::string tempLedger) {
 	//Check if its the latest closed Ledger
 	if(hash == currentLedger.previousLedgerHash && IS_SYNCHRONIZED) {
 		///read new ledger and rollback previous operations
-		txManager->RollbackLedger(tempLedger, ledgerFile, oldTransactionsList);
+		txManager->RollbackLedger(tempLedger, ledgerFile, oldTransactionsList, id);
 
 		//revove unnecessary files
 		std::string previousFiles = LOCAL_DATA_LEDGERS + std::to_string(id);
@@ -660,9 +689,10 @@ void Ledger::FailedToFetch(std::string hash /*=""*/) {
 		bool sent = false;
 		int errorCode;
 		//If it's the latest closed Ledger, ask one of the Nodes that confirmed it
-		auto it = ledgerConsensus.find(hash);
+		Hash160 id;
+		auto it = Hash160::FromHex(hash, id) ? ledgerConsensus.find(id) : ledgerConsensus.end();
 		if(it != ledgerConsensus.end()) {
-			std::vector<std::string> goodNodes = ledgerConsensus[hash].second;
+			std::vector<std::string> goodNodes = it->second.second;
 			while(!sent && goodNodes.size()) {
 				boost::asio::ip::tcp::socket *socket = nodes->WriteToNode(goodNodes.back(), errorCode);
 				if(!errorCode && Network::WriteMessage(*socket, NETWORK_GET_LEDGER, hash, true)) sent = true;
@@ -678,18 +708,24 @@ void Ledger::FailedToFetch(std::string hash /*=""*/) {
 }
 
 void Ledger::StartConsensus() {
-	nodes->BroadcastConfirmation(currentLedger.previousLedgerHash, false);
+	nodes->BroadcastConfirmation(currentLedger.previousLedgerHash, CONFIRMATION_LEDGER);
+
+	Hash160 id;
+	if(!Hash160::FromHex(currentLedger.previousLedgerHash, id)) return;
 
 	std::lock_guard<std::mutex> lock(dataMutex);
-	ledgerConsensus[currentLedger.previousLedgerHash].first++;
+	auto &consensus = ledgerConsensus[id];
+	consensus.first++;
 
-	if(ledgerConsensus[currentLedger.previousLedgerHash].first >= nodes->ConfirmationThreshold(false)) {
+	if(consensus.first >= nodes->ConfirmationThreshold(false)) {
 		EndConsensus(currentLedger.previousLedgerHash, _SELF);
 	}
 }
 
 void Ledger::EndConsensus(std::string hash, std::string node) {
-	std::vector<std::string> goodNodes = ledgerConsensus[hash].second;
+	Hash160 id;
+	Hash160::FromHex(hash, id); //only decoded hashes reach consensus
+	std::vector<std::string> goodNodes = ledgerConsensus[id].second;
 
 	if(hash != currentLedger.previousLedgerHash) {
 		//we built an incorrect Ledger
@@ -732,8 +768,11 @@ void Ledger::EndConsensus(std::string hash, std::string node) {
 
 void Ledger::CleanConsensus() {	
 	//update reputation of the other nodes according to their votes for the latest Ledger
-	nodes->UpdateReputation(ledgerConsensus[currentLedger.previousLedgerHash].second, true, false);
-	ledgerConsensus.erase(currentLedger.previousLedgerHash);
+	Hash160 latest;
+	if(Hash160::FromHex(currentLedger.previousLedgerHash, latest)) {
+		nodes->UpdateReputation(ledgerConsensus[latest].second, true, false);
+		ledgerConsensus.erase(latest);
+	}
 
 	for(auto it = ledgerConsensus.begin(); it != ledgerConsensus.end(); ++it) {
 		nodes->UpdateReputation(it->second.second, false, false);
@@ -743,13 +782,18 @@ void Ledger::CleanConsensus() {
 }
 
 void Ledger::AddConfirmation(std::string hash, std::string node) {
+	//malformed hashes would all be counted as the same vote
+	Hash160 id;
+	if(!Hash160::FromHex(hash, id)) return;
+
 	std::lock_guard<std::mutex> lock(dataMutex);
 	
-	ledgerConsensus[hash].first++;
-	ledgerConsensus[hash].second.push_back(node);
+	auto &consensus = ledgerConsensus[id];
+	consensus.first++;
+	consensus.second.push_back(node);
 
-	if(ledgerConsensus[hash].first >= nodes->ConfirmationThreshold(false)) {
-		EndConsensus(hash, node);
+	if(consensus.first >= nodes->ConfirmationThreshold(false)) {
+		EndConsensus(id.ToHex(), node);
 	} 
 }
 
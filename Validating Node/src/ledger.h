@@ -41,12 +41,13 @@
 #include <fstream>
 #include <map>
 #include <mutex>
-#include <set>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "hash160.h"
+
 class Balances;
 class NetworkManager;
 class Nodes;
@@ -65,7 +66,7 @@ struct LedgerStruct {
 	uint64_t end;
 
 	uint64_t nAccounts = 0;
-	std::set<std::string> transactionsList;
+	std::vector<Hash160> transactionsList; //sorted once the ledger closes
 
 	uint64_t amountInCirculation = 0; 
 	uint64_t amountTraded = 0;
@@ -93,6 +94,7 @@ class Ledger {
 		void RegisterMovements(uint64_t timestamp, std::vector<std::pair<std::string, uint64_t>> &from, std::vector<std::pair<std::string, uint64_t>> &to);
 		void RegisterTransaction(Transaction *Tx);
 		void CloseLedger();
+		std::string JournalPosition();
 
 		void StartConsensus();
 		void EndConsensus(std::string hash, std::string node);
@@ -126,9 +128,9 @@ class Ledger {
 		LedgerStruct nextLedger;
 		std::unordered_map<std::string, int> missingLedgers;
 
-		std::unordered_map<std::string,std::pair<int,std::vector<std::string>>> ledgerConsensus;
+		std::unordered_map<Hash160,std::pair<int,std::vector<std::string>>> ledgerConsensus;
 		uint64_t amountInCirculation = 0;
-		std::set<std::string> oldTransactionsList;
+		std::vector<Hash160> oldTransactionsList;
 
 		void CalculateBalances();
 		void BuildLedger();
@@ -61,6 +61,7 @@
 #include "processing.h"
 #include "publisher.h"
 #include "slots.h"
+#include "stats.h"
 #include "threads_manager.h"
 #include "transaction.h"
 #include "transaction_basic.h"
@@ -87,17 +88,19 @@ void SIGNAL_HANDLER(int param) {
 	}
 }
 
+//Only flags the request, the statistics are printed by the main loop
+volatile std::sig_atomic_t STATS_REQUESTED = 0;
+
+void STATS_HANDLER(int param) {
+	STATS_REQUESTED = 1;
+}
+
 int main() {
 	
 	//create directories if they don't exist
 	boost::filesystem::create_directory(boost::filesystem::path(LOCAL_DATA));
 	boost::filesystem::create_directory(boost::filesystem::path(LOCAL_DATA_DATABASES));
-	boost::filesystem::create_directory(boost::filesystem::path(DATABASE_PUBLIC_KEYS));
-	boost::filesystem::create_directory(boost::filesystem::path(DATABASE_PUBLIC_KEYS_BACKUP));
-	boost::filesystem::create_directory(boost::filesystem::path(DATABASE_SLOTS));
-	boost::filesystem::create_directory(boost::filesystem::path(DATABASE_BALANCES));
-	boost::filesystem::create_directory(boost::filesystem::path(DATABASE_NETWORK_MANAGEMENT));
-	boost::filesystem::create_directory(boost::filesystem::path(DATABASE_NETWORK_MANAGEMENT_BACKUP));
+	boost::filesystem::create_directory(boost::filesystem::path(DATABASE_NODE_BACKUP));
 	boost::filesystem::create_directory(boost::filesystem::path(LOCAL_DATA_LEDGERS));
 	boost::filesystem::create_directory(boost::filesystem::path(LOCAL_DATA_BLOCKS));
 	boost::filesystem::create_directory(boost::filesystem::path(LOCAL_DATA_KEYS));
@@ -109,6 +112,7 @@ int main() {
 		std::cout << "No profile found, creating a new one..." << std::endl;
 		fresh = CreateProfile();
 	}
+	LoadTuning();
 
 	std::cout << "Starting up node..." << std::endl << std::endl;
 
@@ -121,14 +125,23 @@ int main() {
 	//start operation
 	std::cout << "\nLoading databases and creating data structures..." << std::endl;
 
+	//open the node's database, holding every store below
+	rocksdb::DB *nodeDB = Database::LoadNodeDB();
+	if(!nodeDB) {
+		std::cout << "Node's database couldn't be loaded, shutting down." << std::endl;
+		return 1;
+	}
+
 	//create accounts' balances database
-	Balances balancesDB(Database::LoadBalancesDB());
+	Balances balancesDB(nodeDB, Database::Family(DATABASE_PROFILE_BALANCES), Database::Metadata());
+	//apply the operations journaled after the balances were last stored
+	balancesDB.Recover();
 
 	//load public keys database
-	Keys keysDB(Database::LoadKeysDB());
+	Keys keysDB(nodeDB, Database::Family(DATABASE_PROFILE_KEYS));
 
 	//load slots database
-	Slots slotsDB(Database::LoadSlotsDB());
+	Slots slotsDB(nodeDB, Database::Family(DATABASE_PROFILE_SLOTS));
 
 	//load subscribers data
 	Publisher publisher;
@@ -143,7 +156,7 @@ int main() {
 	DASManager managerDAS(&txManager);
 
 	//load network management database
-	NetworkManager networkManager(Database::LoadNetworkManagementDB(), &managerDAO, &managerDAS, &keysDB, &publisher, &slotsDB, threadsManager);
+	NetworkManager networkManager(nodeDB, Database::Family(DATABASE_PROFILE_NETWORK_MANAGEMENT), &managerDAO, &managerDAS, &keysDB, &publisher, &slotsDB, threadsManager);
 
 	//Get reference to Managing Entities data
 	Entities *entities = networkManager.GetEntitiesManager();
@@ -213,6 +226,8 @@ int main() {
 	//listen to shutdown signals
 	signal(SIGINT, SIGNAL_HANDLER);
 	signal(SIGTSTP, SIGNAL_HANDLER);
+	//dump transactions' latencies on demand
+	signal(SIGUSR1, STATS_HANDLER);
 	std::this_thread::sleep_for(std::chrono::milliseconds(500));
 
 	while(true) {
@@ -220,7 +235,15 @@ int main() {
 		std::cout << "\n########################################################################" << std::endl;
 		std::cout << "#Unified Digital Currency - WorldBank's Official Validation Node v0.1.0#" << std::endl;
 		std::cout << "########################################################################" << std::endl;
-		std::this_thread::sleep_for(std::chrono::seconds(60));
+
+		//wake up every second to print the statistics when asked for
+		for(uint i = 0; i < 60; i++) {
+			std::this_thread::sleep_for(std::chrono::seconds(1));
+			if(!STATS_REQUESTED) continue;
+
+			STATS_REQUESTED = 0;
+			std::cout << "\n\n" << Stats::Dump() << std::endl;
+		}
 	}
 
 
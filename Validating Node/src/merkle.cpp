@@ -35,7 +35,6 @@
  * UDC Validating Node.
  */
 
-#include <set>
 #include <string>
 #include <vector>
 
@@ -44,10 +43,12 @@
 #include "includes/cryptopp/hex.h"
 
 #include "globals.h"
+#include "hash160.h"
 #include "merkle.h"
 
 
-std::string Crypto::MerkleRoot(std::set<std::string> &list) {
+std::string Crypto::MerkleRoot(const std::vector<Hash160> &list) {
+	//list must be sorted, leaves are the hex forms as always
 	int num = list.size();
 
 	//return zero-length hash if empty list
@@ -104,12 +105,12 @@ std::string Crypto::MerkleRoot(std::set<std::string> &list) {
 		for (listIterator; i < *parentsIterator && listIterator != list.end(); ++listIterator, i++) {
 			if (pair) {
 				std::string hash;
-				CryptoPP::StringSource ss(content + *listIterator, true, new CryptoPP::HashFilter(ripemd, new CryptoPP::HexEncoder(new CryptoPP::StringSink(hash))));
+				CryptoPP::StringSource ss(content + listIterator->ToHex(), true, new CryptoPP::HashFilter(ripemd, new CryptoPP::HexEncoder(new CryptoPP::StringSink(hash))));
 				parents.push_back(hash);
 				pair = false;
 			}
 			else {
-				content = *listIterator;
+				content = listIterator->ToHex();
 				pair = true;
 			}
 		}
@@ -38,13 +38,15 @@
 #ifndef MERKLE_H
 #define MERKLE_H
 
-#include <set>
 #include <string>
+#include <vector>
+
+class Hash160;
 
 
 namespace Crypto {
 
-	std::string MerkleRoot(std::set<std::string> &transactionsList);
+	std::string MerkleRoot(const std::vector<Hash160> &list);
 
 }
 
@@ -91,6 +91,15 @@ bool ModulesInterface::GetPublicKey(std::string id, std::string &publicKey, int
 bool ModulesInterface::GetManagingEntityKey(std::string account, std::string &key) {
 	return keysDB->GetManagingEntityKey(account, key);
 }
+bool ModulesInterface::GetPublicKey(std::string id, SignatureStruct &signature, int idType /*=ID_TYPE_ACCOUNT*/) {
+	return keysDB->GetPublicKey(id, signature, idType);
+}
+bool ModulesInterface::GetManagingEntityKey(std::string account, SignatureStruct &signature) {
+	return keysDB->GetManagingEntityKey(account, signature);
+}
+void ModulesInterface::PrefetchPublicKeys(const std::vector<std::string> &ids) {
+	keysDB->Prefetch(ids);
+}
 
 //Ledger
 bool ModulesInterface::GetLedger(std::string hash, std::string &ledgerFile) {
@@ -40,6 +40,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "codes.h"
 
@@ -60,6 +61,7 @@ class RequestDelayedTransaction;
 class Transaction;
 class TransactionsManager;
 class Slots;
+struct SignatureStruct;
 
 
 class ModulesInterface {
@@ -85,6 +87,9 @@ class ModulesInterface {
 		//Keys Database
 		bool GetPublicKey(std::string id, std::string &publicKey, int idType=ID_TYPE_ACCOUNT, bool request=true);
 		bool GetManagingEntityKey(std::string account, std::string &key);
+		bool GetPublicKey(std::string id, SignatureStruct &signature, int idType=ID_TYPE_ACCOUNT);
+		bool GetManagingEntityKey(std::string account, SignatureStruct &signature);
+		void PrefetchPublicKeys(const std::vector<std::string> &ids);
 
 		//Ledger
 		bool GetLedger(std::string hash, std::string &ledgerFile);
@@ -370,6 +370,34 @@ bool Network::WriteMessage(boost::asio::ip::tcp::socket &socket, int protocolCod
 	return !error;
 }
 
+bool Network::WriteSignedMessage(boost::asio::ip::tcp::socket &socket, int protocolCode, const std::string &content, const std::string &signature) {
+	std::vector<char> message;
+
+	//add protocol code
+	Util::int_to_array(protocolCode, NETWORK_CODE_LENGTH, 0, message);
+	uint offset = NETWORK_CODE_LENGTH;
+
+	//add data total length
+	Util::int_to_array(NETWORK_SIGNATURE_LENGTH+signature.length()+content.length(), NETWORK_DATA_LENGTH, offset, message);
+	offset += NETWORK_DATA_LENGTH;
+
+	//add the signature computed once by the caller
+	Util::int_to_array(signature.length(), NETWORK_SIGNATURE_LENGTH, offset, message);
+	offset += NETWORK_SIGNATURE_LENGTH;
+	Util::string_to_array(signature, signature.length(), offset, message);
+	offset += signature.length();
+
+	//add content
+	Util::string_to_array(content, content.length(), offset, message);
+
+	//send the message to the peer node
+	boost::system::error_code error;
+	boost::asio::write(socket, boost::asio::buffer(message), boost::asio::transfer_all(), error);
+
+	//verify it there was an error
+	return !error;
+}
+
 bool Network::SendFile(boost::asio::ip::tcp::socket &socket, int protocolCode, std::string file) {
 	std::fstream data(file, std::fstream::in);
 	if(data.good()) {
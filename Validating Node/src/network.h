@@ -53,6 +53,7 @@ namespace Network {
 
 	bool WriteMessage(boost::asio::ip::tcp::socket &socket, int protocolCode, std::string message, bool sign);
 	bool WriteMessage(boost::asio::ip::tcp::socket &socket, int protocolCode, std::string content, std::string variableContent, int variableLength, bool variableFirst, bool sign);
+	bool WriteSignedMessage(boost::asio::ip::tcp::socket &socket, int protocolCode, const std::string &content, const std::string &signature);
 	bool SendFile(boost::asio::ip::tcp::socket &socket, int protocolCode, std::string file);
 	bool SendKeepAlive(boost::asio::ip::tcp::socket &socket);
 
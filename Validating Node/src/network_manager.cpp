@@ -43,6 +43,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "includes/boost/filesystem.hpp"
 #include "includes/boost/regex.hpp"
@@ -51,7 +52,6 @@
 #include "includes/cryptopp/hex.h"
 #include "includes/rocksdb/db.h"
 #include "includes/rocksdb/iterator.h"
-#include "includes/rocksdb/utilities/backupable_db.h"
 #include "includes/rocksdb/write_batch.h"
 
 #include "balances.h"
@@ -60,6 +60,7 @@
 #include "configurations.h"
 #include "dao_manager.h"
 #include "das_manager.h"
+#include "database.h"
 #include "ecdsa.h"
 #include "entity.h"
 #include "entry.h"
@@ -72,6 +73,7 @@
 #include "entry_resource.h"
 #include "entry_slot.h"
 #include "globals.h"
+#include "hash160.h"
 #include "keys.h"
 #include "merkle.h"
 #include "network.h"
@@ -83,9 +85,12 @@
 #include "util.h"
 
 
-NetworkManager::NetworkManager(rocksdb::DB *db, DAOManager *managerDAO, DASManager *managerDAS, Keys *keysDB, Publisher *publisher, Slots *slotsDB, ThreadsManager *threadsManager)
- : db(db), managerDAO(managerDAO), managerDAS(managerDAS), keysDB(keysDB), publisher(publisher), slotsDB(slotsDB), threadsManager(threadsManager) {
-	rocksdb::Iterator* dbIterator = db->NewIterator(rocksdb::ReadOptions());
+NetworkManager::NetworkManager(rocksdb::DB *db, rocksdb::ColumnFamilyHandle *family, DAOManager *managerDAO, DASManager *managerDAS, Keys *keysDB, Publisher *publisher, Slots *slotsDB, ThreadsManager *threadsManager)
+ : db(db), family(family), managerDAO(managerDAO), managerDAS(managerDAS), keysDB(keysDB), publisher(publisher), slotsDB(slotsDB), threadsManager(threadsManager) {
+	//the whole database is walked, not a single mask prefix
+	rocksdb::ReadOptions readOptions;
+	readOptions.total_order_seek = true;
+	rocksdb::Iterator* dbIterator = db->NewIterator(readOptions, family);
 	rocksdb::Status status;
  	std::string id, publicKey, host, version, account, reputation;
 
@@ -179,7 +184,7 @@ bool NetworkManager::GetEntityData(std::string id, EntityStruct &entity) {
 
 	if(!keysDB->GetPublicKey(id, entity.publicKey, ID_TYPE_ENTITY, false)) return false;
 
-	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), id+NMDB_MASK_HOST, &entity.host);
+	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), family, id+NMDB_MASK_HOST, &entity.host);
 	if(status.IsNotFound()) return false;
 
 	return true;
@@ -190,17 +195,17 @@ bool NetworkManager::GetNodeData(std::string id, NodeStruct &node) {
 
 	if(!keysDB->GetPublicKey(id, node.publicKey, ID_TYPE_NODE, false)) return false;
 
-	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), id+NMDB_MASK_HOST, &node.host);
+	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), family, id+NMDB_MASK_HOST, &node.host);
 	if(status.IsNotFound()) return false;
 
-	status = db->Get(rocksdb::ReadOptions(), id+NMDB_MASK_VERSION, &node.version);
+	status = db->Get(rocksdb::ReadOptions(), family, id+NMDB_MASK_VERSION, &node.version);
 	if(status.IsNotFound()) return false;
 
 	std::string value;
-	status = db->Get(rocksdb::ReadOptions(), id+NMDB_MASK_ACCOUNT, &value);
+	status = db->Get(rocksdb::ReadOptions(), family, id+NMDB_MASK_ACCOUNT, &value);
 	if(!status.IsNotFound()) node.account = value;
 
-	status = db->Get(rocksdb::ReadOptions(), id+NMDB_MASK_REPUTATION, &value);
+	status = db->Get(rocksdb::ReadOptions(), family, id+NMDB_MASK_REPUTATION, &value);
 	if(!status.IsNotFound()) node.reputation = std::stol(value);
 
 	return true;
@@ -209,7 +214,7 @@ bool NetworkManager::GetNodeData(std::string id, NodeStruct &node) {
 void NetworkManager::SynchronizeNMB() {
 	int nextBlock = GENESIS_BLOCK_ID;
 
-	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), NMDB_MASK_BLOCK+std::to_string(GENESIS_BLOCK_ID), &latestBlock);
+	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), family, NMDB_MASK_BLOCK+std::to_string(GENESIS_BLOCK_ID), &latestBlock);
 	if(status.IsNotFound()) {
 		//Try to execute the Genesis Network Management Block
 		SetBlock(LOCAL_DATA_BLOCKS+std::to_string(GENESIS_BLOCK_ID)+BLOCK_EXTENSION);
@@ -218,7 +223,7 @@ void NetworkManager::SynchronizeNMB() {
 		//Find the latest registered Block
 		while(!status.IsNotFound()) {
 			nextBlock++;
-			status = db->Get(rocksdb::ReadOptions(), NMDB_MASK_BLOCK+std::to_string(nextBlock), &latestBlock);
+			status = db->Get(rocksdb::ReadOptions(), family, NMDB_MASK_BLOCK+std::to_string(nextBlock), &latestBlock);
 		}
 	}
 
@@ -332,7 +337,7 @@ Ledger* NetworkManager::SynchronizeLedgers(Balances *balancesDB, TransactionsMan
 	uint nextId = GENESIS_LEDGER_ID;
 	std::string hash;
 
-	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), NMDB_MASK_LEDGER+std::to_string(GENESIS_LEDGER_ID), &hash);
+	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), family, NMDB_MASK_LEDGER+std::to_string(GENESIS_LEDGER_ID), &hash);
 	if(status.IsNotFound()) {
 
 		//Verify Genesis Ledger file, create if it doesn't exist
@@ -351,17 +356,17 @@ Ledger* NetworkManager::SynchronizeLedgers(Balances *balancesDB, TransactionsMan
 
 		//Start Ledger chain inside the database
 		rocksdb::WriteBatch batch;
-		batch.Put(NMDB_MASK_LEDGER+std::to_string(GENESIS_LEDGER_ID), GENESIS_LEDGER_HASH);
-		batch.Put(NMDB_MASK_LEDGER+GENESIS_LEDGER_HASH, std::to_string(GENESIS_LEDGER_ID));
-		batch.Put(NMDB_MASK_LEDGER+GENESIS_LEDGER_HASH+NMDB_MASK_OPEN, "0");
-		batch.Put(NMDB_MASK_LEDGER+GENESIS_LEDGER_HASH+NMDB_MASK_CLOSE, std::to_string(GENESIS_LEDGER_END));
+		batch.Put(family, NMDB_MASK_LEDGER+std::to_string(GENESIS_LEDGER_ID), GENESIS_LEDGER_HASH);
+		batch.Put(family, NMDB_MASK_LEDGER+GENESIS_LEDGER_HASH, std::to_string(GENESIS_LEDGER_ID));
+		batch.Put(family, NMDB_MASK_LEDGER+GENESIS_LEDGER_HASH+NMDB_MASK_OPEN, "0");
+		batch.Put(family, NMDB_MASK_LEDGER+GENESIS_LEDGER_HASH+NMDB_MASK_CLOSE, std::to_string(GENESIS_LEDGER_END));
 		db->Write(rocksdb::WriteOptions(), &batch);
 	}
 	else {
 		while(!status.IsNotFound()) {
 			latestLedger = hash;
 			nextId++;
-			status = db->Get(rocksdb::ReadOptions(), NMDB_MASK_LEDGER+std::to_string(nextId), &hash);
+			status = db->Get(rocksdb::ReadOptions(), family, NMDB_MASK_LEDGER+std::to_string(nextId), &hash);
 		}
 	}
 
@@ -471,15 +476,15 @@ void NetworkManager::CheckSelf(std::string publicKey /*=NULL*/, bool changed /*=
 	std::string value;
 	bool account, version;
 
-	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), _SELF+NMDB_MASK_ACCOUNT, &value);
+	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), family, _SELF+NMDB_MASK_ACCOUNT, &value);
 	if(!status.IsNotFound() && _ACCOUNT != value) {
-		db->Put(rocksdb::WriteOptions(), _SELF+NMDB_MASK_ACCOUNT, _ACCOUNT);
+		db->Put(rocksdb::WriteOptions(), family, _SELF+NMDB_MASK_ACCOUNT, _ACCOUNT);
 		account = true;
 	}
 
-	status = db->Get(rocksdb::ReadOptions(), _SELF+NMDB_MASK_VERSION, &value);
+	status = db->Get(rocksdb::ReadOptions(), family, _SELF+NMDB_MASK_VERSION, &value);
 	if(!status.IsNotFound() && CURRENT_VERSION != value) {
-		db->Put(rocksdb::WriteOptions(), _SELF+NMDB_MASK_VERSION, CURRENT_VERSION);
+		db->Put(rocksdb::WriteOptions(), family, _SELF+NMDB_MASK_VERSION, CURRENT_VERSION);
 		version = true;
 	}
 
@@ -518,21 +523,13 @@ bool NetworkManager::BackupData() {
 	//Update Nodes with latest reputations
 	std::unordered_map<std::string, int> rep = nodes->GetReputation();
 	rocksdb::WriteBatch batch;
-	for(auto it = rep.begin(); it != rep.end(); ++it) batch.Put(it->first+NMDB_MASK_REPUTATION, std::to_string(it->second));
+	for(auto it = rep.begin(); it != rep.end(); ++it) batch.Put(family, it->first+NMDB_MASK_REPUTATION, std::to_string(it->second));
 
 	std::lock_guard<std::mutex> lock(dataMutex);
 	rocksdb::Status status = db->Write(rocksdb::WriteOptions(), &batch);
 
 	//Create a new database backup
-	rocksdb::BackupEngine* backup_engine;
-    status = rocksdb::BackupEngine::Open(rocksdb::Env::Default(), rocksdb::BackupableDBOptions(DATABASE_NETWORK_MANAGEMENT_BACKUP), &backup_engine);
-
-    if(status.ok()) {
-    	backup_engine->CreateNewBackup(db);
-    	delete backup_engine;
-    	return true;
-    }
-    return false;
+	return Database::BackupData(db);
 }
 
 Entities* NetworkManager::GetEntitiesManager() {
@@ -611,8 +608,8 @@ void NetworkManager::RevertSlotManager(uint now, std::string slot, std::string m
 
 	while(true) {
 		//Retrieve validity and supervisor
-		status1 = db->Get(rocksdb::ReadOptions(), slot+NMDB_MASK_DELIMITER+manager+NMDB_MASK_VALIDITY, &validity);
-		status2 = db->Get(rocksdb::ReadOptions(), slot+NMDB_MASK_DELIMITER+manager+NMDB_MASK_SUPERVISOR, &next);
+		status1 = db->Get(rocksdb::ReadOptions(), family, slot+NMDB_MASK_DELIMITER+manager+NMDB_MASK_VALIDITY, &validity);
+		status2 = db->Get(rocksdb::ReadOptions(), family, slot+NMDB_MASK_DELIMITER+manager+NMDB_MASK_SUPERVISOR, &next);
 
 		//No validity speficied or still within accepted period
 		if(status1.IsNotFound() || std::stoul(validity) > now) {
@@ -629,11 +626,11 @@ void NetworkManager::RevertSlotManager(uint now, std::string slot, std::string m
 		//Expired but has a supervisor
 		else {
 			//Remove unnecessary data
-			batch.Delete(slot+NMDB_MASK_DELIMITER+manager+NMDB_MASK_START);
-			batch.Delete(slot+NMDB_MASK_DELIMITER+manager+NMDB_MASK_VALIDITY);
-			batch.Delete(slot+NMDB_MASK_DELIMITER+manager+NMDB_MASK_SUPERVISOR);
-			batch.Delete(slot+NMDB_MASK_DELIMITER+manager+NMDB_MASK_SUPERVISING);
-			batch.Delete(slot+NMDB_MASK_DELIMITER+next+NMDB_MASK_SUPERVISING);
+			batch.Delete(family, slot+NMDB_MASK_DELIMITER+manager+NMDB_MASK_START);
+			batch.Delete(family, slot+NMDB_MASK_DELIMITER+manager+NMDB_MASK_VALIDITY);
+			batch.Delete(family, slot+NMDB_MASK_DELIMITER+manager+NMDB_MASK_SUPERVISOR);
+			batch.Delete(family, slot+NMDB_MASK_DELIMITER+manager+NMDB_MASK_SUPERVISING);
+			batch.Delete(family, slot+NMDB_MASK_DELIMITER+next+NMDB_MASK_SUPERVISING);
 			//Check its supervisor
 			manager = next;
 		}
@@ -692,7 +689,7 @@ bool NetworkManager::AddEntry(std::string hash, std::string content, int &errorC
 
 		//Check if the Entry's type is supported by the resource
 		std::string value;
-		rocksdb::Status status = db->Get(rocksdb::ReadOptions(), newEntry->GetResource()+NMDB_MASK_ENTRY_TYPE+newEntry->GetType(), &value);
+		rocksdb::Status status = db->Get(rocksdb::ReadOptions(), family, newEntry->GetResource()+NMDB_MASK_ENTRY_TYPE+newEntry->GetType(), &value);
 		if(status.IsNotFound()) {
 			errorCode = ERROR_UNSUPPORTED;
 			goto Reject;
@@ -733,12 +730,12 @@ bool NetworkManager::AddEntry(std::string hash, std::string content, int &errorC
 bool NetworkManager::IsAuthorized(Entry *newEntry, int &errorCode) {
 	//Verify if signer is the resource's supervisor
 	std::string supervisor;
-	db->Get(rocksdb::ReadOptions(), newEntry->GetResource()+NMDB_MASK_SUPERVISOR, &supervisor);
+	db->Get(rocksdb::ReadOptions(), family, newEntry->GetResource()+NMDB_MASK_SUPERVISOR, &supervisor);
 	if(newEntry->GetSigner() == supervisor) return true;
 
 	//otherwise, if he has the appropriate privileges
 	std::string protection, value;
-	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), newEntry->GetResource()+NMDB_MASK_PROTECTION, &protection);
+	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), family, newEntry->GetResource()+NMDB_MASK_PROTECTION, &protection);
 	if(status.IsNotFound()) protection = DEFAULT_RESOURCE_PROTECTION;
 
 	//Private resource, only its supervisor can use it
@@ -762,7 +759,7 @@ bool NetworkManager::IsAuthorized(Entry *newEntry, int &errorCode) {
 		//otherwise, check if signer is a supervisor
 		else {
 			//For cancel and renew entries, signer must be the specified manager's immediate supervisor
-			status = db->Get(rocksdb::ReadOptions(), slot+NMDB_MASK_DELIMITER+newEntry->GetSigner()+NMDB_MASK_SUPERVISING, &supervisor);
+			status = db->Get(rocksdb::ReadOptions(), family, slot+NMDB_MASK_DELIMITER+newEntry->GetSigner()+NMDB_MASK_SUPERVISING, &supervisor);
 			if(newEntry->GetType() != ENTRY_TYPE_UPDATE) {
 				if(status.IsNotFound() || dynamic_cast<SlotEntry*>(newEntry)->GetManager() != supervisor) return false;
 				//Since cancel doesn't have optional fields, it is authorized
@@ -770,7 +767,7 @@ bool NetworkManager::IsAuthorized(Entry *newEntry, int &errorCode) {
 
 				//For renew type, if start is specified, entry's creation date must be after the specified manager's start date
 				if(dynamic_cast<SlotEntry*>(newEntry)->GetStart(time)) {
-					status = db->Get(rocksdb::ReadOptions(), slot+NMDB_MASK_DELIMITER+dynamic_cast<SlotEntry*>(newEntry)->GetManager()+NMDB_MASK_START, &value);
+					status = db->Get(rocksdb::ReadOptions(), family, slot+NMDB_MASK_DELIMITER+dynamic_cast<SlotEntry*>(newEntry)->GetManager()+NMDB_MASK_START, &value);
 					if(!status.IsNotFound() && newEntry->GetTimestamp() > std::stoul(value)) return false;
 				}
 			}
@@ -778,13 +775,13 @@ bool NetworkManager::IsAuthorized(Entry *newEntry, int &errorCode) {
 			else {
 				bool isSupervisor = false;
 				supervisor = manager;
-				status = db->Get(rocksdb::ReadOptions(), slot+NMDB_MASK_DELIMITER+supervisor+NMDB_MASK_SUPERVISOR, &supervisor);
+				status = db->Get(rocksdb::ReadOptions(), family, slot+NMDB_MASK_DELIMITER+supervisor+NMDB_MASK_SUPERVISOR, &supervisor);
 				while(!status.IsNotFound()) {
 					if(newEntry->GetSigner() == supervisor) {
 						isSupervisor = true;
 						break;
 					}
-					status = db->Get(rocksdb::ReadOptions(), slot+NMDB_MASK_DELIMITER+supervisor+NMDB_MASK_SUPERVISOR, &supervisor);
+					status = db->Get(rocksdb::ReadOptions(), family, slot+NMDB_MASK_DELIMITER+supervisor+NMDB_MASK_SUPERVISOR, &supervisor);
 				}
 				//then verify if it is
 				if(!isSupervisor) return false;
@@ -794,13 +791,13 @@ bool NetworkManager::IsAuthorized(Entry *newEntry, int &errorCode) {
 
 		//If a start date was specified, check that it respects the signer's own start date
 		if(dynamic_cast<SlotEntry*>(newEntry)->GetStart(time)) {
-			status = db->Get(rocksdb::ReadOptions(), slot+NMDB_MASK_DELIMITER+newEntry->GetSigner()+NMDB_MASK_START, &value);
+			status = db->Get(rocksdb::ReadOptions(), family, slot+NMDB_MASK_DELIMITER+newEntry->GetSigner()+NMDB_MASK_START, &value);
 			if(!status.IsNotFound() && time < std::stoul(value)) return false;
 		}
 
 		//If a validity date was specified, check that it doesn't surpass the signer's privilege
 		if(dynamic_cast<SlotEntry*>(newEntry)->GetValidity(time)) {
-			status = db->Get(rocksdb::ReadOptions(), slot+NMDB_MASK_DELIMITER+newEntry->GetSigner()+NMDB_MASK_VALIDITY, &value);
+			status = db->Get(rocksdb::ReadOptions(), family, slot+NMDB_MASK_DELIMITER+newEntry->GetSigner()+NMDB_MASK_VALIDITY, &value);
 			if(!status.IsNotFound() && time > std::stoul(value)) return false;
 		}
 		return true;
@@ -818,7 +815,7 @@ bool NetworkManager::IsAuthorized(Entry *newEntry, int &errorCode) {
 	//Remaining public resources
 	std::string id;
 	if(newEntry->GetId(id)) {
-		status = db->Get(rocksdb::ReadOptions(), newEntry->GetResource()+NMDB_MASK_DELIMITER+id, &value);
+		status = db->Get(rocksdb::ReadOptions(), family, newEntry->GetResource()+NMDB_MASK_DELIMITER+id, &value);
 		//Existing ID for this resource, ensure it matches the signer
 		if(!status.IsNotFound()) return (newEntry->GetSigner() == value);
 	}
@@ -845,7 +842,7 @@ bool NetworkManager::ExecuteEntry(Entry *entry, bool newEntry, int &errorCode) {
 		///since it may not have been properly handled by IsAuthorized and will lead to registration of unauthorized NMEs
 		std::string id;
 		if(entry->GetId(id)) {
-			rocksdb::Status status = db->Put(rocksdb::WriteOptions(), entry->GetResource()+NMDB_MASK_DELIMITER+id, id);
+			rocksdb::Status status = db->Put(rocksdb::WriteOptions(), family, entry->GetResource()+NMDB_MASK_DELIMITER+id, id);
 			if(status.ok()) errorCode = ERROR_UNSUPPORTED; 
 		}
 		else errorCode = ERROR_UNSUPPORTED;
@@ -861,12 +858,12 @@ bool NetworkManager::ExecuteResourceEntry(ResourceEntry *entry, bool newEntry, i
 	std::string key = NMB_RESOURCE+NMDB_MASK_DELIMITER+entry->GetDesignation();
 
 	//If cancel, remove resource designation
-	if(entry->GetType() == ENTRY_TYPE_CANCEL) db->Delete(rocksdb::WriteOptions(), key);
+	if(entry->GetType() == ENTRY_TYPE_CANCEL) db->Delete(rocksdb::WriteOptions(), family, key);
 
 	else {
 		if(entry->GetType() == ENTRY_TYPE_CREATE || entry->GetType() == ENTRY_TYPE_RENEW) {
 			//Keep resource designation
-			status = db->Put(rocksdb::WriteOptions(), key, entry->GetDesignation());
+			status = db->Put(rocksdb::WriteOptions(), family, key, entry->GetDesignation());
 			if(!status.ok()) {
 				errorCode = ERROR_UNSUPPORTED;
 				return false;
@@ -883,21 +880,21 @@ bool NetworkManager::ExecuteResourceEntry(ResourceEntry *entry, bool newEntry, i
 					return false;
 				}
 			}
-			batch.Put(entry->GetDesignation()+NMDB_MASK_SUPERVISOR, value);
+			batch.Put(family, entry->GetDesignation()+NMDB_MASK_SUPERVISOR, value);
 		}
 		if(entry->GetProtection(value)) {
 			if(newEntry && value != RESOURCE_PROTECTION_PRIVATE && value != RESOURCE_PROTECTION_RESTRICTED && value != RESOURCE_PROTECTION_PUBLIC) {
 				errorCode = ERROR_DATA_CONTENT;
 				return false;
 			}
-			batch.Put(entry->GetDesignation()+NMDB_MASK_PROTECTION, value);
+			batch.Put(family, entry->GetDesignation()+NMDB_MASK_PROTECTION, value);
 		}
 
 		std::vector<std::string> list = entry->GetIdentifier();
 		if(list.size()) {
 			value = "";
 			for(auto it = list.begin(); it != list.end(); ++it) value += *it+NMDB_MASK_DELIMITER;
-			batch.Put(entry->GetDesignation()+NMDB_MASK_IDENTIFIER, value);
+			batch.Put(family, entry->GetDesignation()+NMDB_MASK_IDENTIFIER, value);
 		}
 
 		list = entry->GetOperation();
@@ -911,7 +908,7 @@ bool NetworkManager::ExecuteResourceEntry(ResourceEntry *entry, bool newEntry, i
 					errorCode = ERROR_DATA_CONTENT;
 					return false;
 				}
-				batch.Put(entry->GetDesignation()+NMDB_MASK_ENTRY_TYPE+*it, *it);
+				batch.Put(family, entry->GetDesignation()+NMDB_MASK_ENTRY_TYPE+*it, *it);
 			}
 		}
 
@@ -927,12 +924,12 @@ bool NetworkManager::ExecutePassportEntry(PassportEntry *entry, bool newEntry, i
 	std::string key = NMB_RESOURCE_PASSPORT+NMDB_MASK_DELIMITER+entry->GetPassport();
 
 	//If cancel, remove Passport ID
-	if(entry->GetType() == ENTRY_TYPE_CANCEL) db->Delete(rocksdb::WriteOptions(), key);
+	if(entry->GetType() == ENTRY_TYPE_CANCEL) db->Delete(rocksdb::WriteOptions(), family, key);
 
 	else {
 		if(entry->GetType() == ENTRY_TYPE_CREATE || entry->GetType() == ENTRY_TYPE_RENEW) {
 			//Keep passport ID
-			status = db->Put(rocksdb::WriteOptions(), key, entry->GetPassport());
+			status = db->Put(rocksdb::WriteOptions(), family, key, entry->GetPassport());
 			if(!status.ok()) {
 				errorCode = ERROR_UNSUPPORTED;
 				return false;
@@ -963,12 +960,12 @@ bool NetworkManager::ExecuteEntityEntry(EntityEntry *entry, bool newEntry, int &
 
 	//If cancel, remove Entity ID
 	if(entry->GetType() == ENTRY_TYPE_CANCEL) {
-		db->Delete(rocksdb::WriteOptions(), key);
+		db->Delete(rocksdb::WriteOptions(), family, key);
 		numPeers--;
 	}
 	else if(entry->GetType() == ENTRY_TYPE_CREATE || entry->GetType() == ENTRY_TYPE_RENEW) {
 		//Keep Entity ID
-		status = db->Put(rocksdb::WriteOptions(), key, entry->GetEntity());
+		status = db->Put(rocksdb::WriteOptions(), family, key, entry->GetEntity());
 		if(!status.ok()) {
 			errorCode = ERROR_UNSUPPORTED;
 			return false;
@@ -988,7 +985,7 @@ bool NetworkManager::ExecuteEntityEntry(EntityEntry *entry, bool newEntry, int &
 				valueRegex.assign(PATTERN_PASSPORT_ID);
 				if(!boost::regex_match(value, valueRegex)) return false;
 			}
-			batch.Put(entry->GetEntity()+NMDB_MASK_PASSPORT, value);
+			batch.Put(family, entry->GetEntity()+NMDB_MASK_PASSPORT, value);
 		}
 
 		//Retrieve host
@@ -997,10 +994,10 @@ bool NetworkManager::ExecuteEntityEntry(EntityEntry *entry, bool newEntry, int &
 				valueRegex.assign(PATTERN_HOST);
 				if(!boost::regex_match(host, valueRegex)) return false;
 			}
-			batch.Put(entry->GetEntity()+NMDB_MASK_HOST, host);
+			batch.Put(family, entry->GetEntity()+NMDB_MASK_HOST, host);
 		}
 		else {
-			status = db->Get(rocksdb::ReadOptions(), entry->GetEntity()+NMDB_MASK_HOST, &host);
+			status = db->Get(rocksdb::ReadOptions(), family, entry->GetEntity()+NMDB_MASK_HOST, &host);
 			if(status.IsNotFound()) return false;
 		}
 
@@ -1010,16 +1007,18 @@ bool NetworkManager::ExecuteEntityEntry(EntityEntry *entry, bool newEntry, int &
 				valueRegex.assign(PATTERN_ACCOUNT);
 				if(!boost::regex_match(value, valueRegex)) return false;
 			}
-			batch.Put(entry->GetEntity()+NMDB_MASK_ACCOUNT, value);
+			batch.Put(family, entry->GetEntity()+NMDB_MASK_ACCOUNT, value);
 		}
 
-		//Retrieve public key
-		if(entry->GetPublicKey(publicKey) && !keysDB->SetPublicKey(entry->GetEntity(), publicKey, ID_TYPE_ENTITY)) return false;
-		else if(!keysDB->GetPublicKey(entry->GetEntity(), publicKey, ID_TYPE_ENTITY, false)) return false;
+		//Retrieve public key, a new one is written along with the entry
+		bool NEW_KEY = entry->GetPublicKey(value);
+		if(NEW_KEY && !keysDB->SetPublicKey(batch, entry->GetEntity(), value, publicKey, ID_TYPE_ENTITY)) return false;
+		else if(!NEW_KEY && !keysDB->GetPublicKey(entry->GetEntity(), publicKey, ID_TYPE_ENTITY, false)) return false;
 
 		//Commit updates
 		status = db->Write(rocksdb::WriteOptions(), &batch);
 		if(!status.ok()) return false;
+		if(NEW_KEY) keysDB->Invalidate(entry->GetEntity());
 
 		//Add the Managing Entity to its manager
 		entities->NewEntity(entry->GetEntity(), publicKey, host);
@@ -1038,14 +1037,14 @@ bool NetworkManager::ExecuteEntityEntry(EntityEntry *entry, bool newEntry, int &
 				valueRegex.assign(PATTERN_PASSPORT_ID);
 				if(!boost::regex_match(value, valueRegex)) return false;
 			}
-			batch.Put(entry->GetEntity()+NMDB_MASK_PASSPORT, value);
+			batch.Put(family, entry->GetEntity()+NMDB_MASK_PASSPORT, value);
 		}
 		if(entry->GetHost(value)) {
 			if(newEntry) {
 				valueRegex.assign(PATTERN_HOST);
 				if(!boost::regex_match(value, valueRegex)) return false;
 			}
-			batch.Put(entry->GetEntity()+NMDB_MASK_HOST, value);
+			batch.Put(family, entry->GetEntity()+NMDB_MASK_HOST, value);
 			//Update host directly into Entities manager as well
 			entities->SetHost(entry->GetEntity(), value, newEntry);
 		}
@@ -1054,17 +1053,21 @@ bool NetworkManager::ExecuteEntityEntry(EntityEntry *entry, bool newEntry, int &
 				valueRegex.assign(PATTERN_ACCOUNT);
 				if(!boost::regex_match(value, valueRegex)) return false;
 			}
-			batch.Put(entry->GetEntity()+NMDB_MASK_ACCOUNT, value);
+			batch.Put(family, entry->GetEntity()+NMDB_MASK_ACCOUNT, value);
 		}
 
+		//Verify if it has a public key to register
+		std::string publicKey, stored;
+		bool NEW_KEY = entry->GetPublicKey(publicKey);
+		if(NEW_KEY && !keysDB->SetPublicKey(batch, entry->GetEntity(), publicKey, stored, ID_TYPE_ENTITY)) return false;
+
 		//Execute updates
 		status = db->Write(rocksdb::WriteOptions(), &batch);
 		if(!status.ok()) return false;
 
-		//Verify if it has a public key to register
-		if(entry->GetPublicKey(value)) {
-			if(!keysDB->SetPublicKey(entry->GetEntity(), value, ID_TYPE_ENTITY)) return false;
-			entities->SetPublicKey(entry->GetEntity(), value);
+		if(NEW_KEY) {
+			keysDB->Invalidate(entry->GetEntity());
+			entities->SetPublicKey(entry->GetEntity(), publicKey);
 		}
 	}
 
@@ -1101,7 +1104,7 @@ bool NetworkManager::ExecuteNodeEntry(NodeEntry *entry, bool newEntry, int &erro
 					valueRegex.assign(PATTERN_NETWORK_VERSION);
 					if(!boost::regex_match(value, valueRegex)) return false;
 				}
-				batch.Put(entry->GetNode()+NMDB_MASK_VERSION, value);
+				batch.Put(family, entry->GetNode()+NMDB_MASK_VERSION, value);
 				//Update our version
 				CURRENT_VERSION = value;
 			}
@@ -1112,7 +1115,7 @@ bool NetworkManager::ExecuteNodeEntry(NodeEntry *entry, bool newEntry, int &erro
 					valueRegex.assign(PATTERN_ACCOUNT);
 					if(!boost::regex_match(value, valueRegex)) return false;
 				}
-				batch.Put(entry->GetNode()+NMDB_MASK_ACCOUNT, value);
+				batch.Put(family, entry->GetNode()+NMDB_MASK_ACCOUNT, value);
 				_ACCOUNT = value;
 			}
 
@@ -1124,12 +1127,12 @@ bool NetworkManager::ExecuteNodeEntry(NodeEntry *entry, bool newEntry, int &erro
 
 	//If cancel, remove Node ID
 	else if(entry->GetType() == ENTRY_TYPE_CANCEL) {
-		db->Delete(rocksdb::WriteOptions(), key);
+		db->Delete(rocksdb::WriteOptions(), family, key);
 		numPeers--;
 	}
 	else if(entry->GetType() == ENTRY_TYPE_CREATE || entry->GetType() == ENTRY_TYPE_RENEW) {
 		//Keep Node ID
-		status = db->Put(rocksdb::WriteOptions(), key, entry->GetNode());
+		status = db->Put(rocksdb::WriteOptions(), family, key, entry->GetNode());
 		if(!status.ok()) {
 			errorCode = ERROR_UNSUPPORTED;
 			return false;
@@ -1148,7 +1151,7 @@ bool NetworkManager::ExecuteNodeEntry(NodeEntry *entry, bool newEntry, int &erro
 				valueRegex.assign(PATTERN_PASSPORT_ID);
 				if(!boost::regex_match(value, valueRegex)) return false;
 			}
-			batch.Put(entry->GetNode()+NMDB_MASK_PASSPORT, value);
+			batch.Put(family, entry->GetNode()+NMDB_MASK_PASSPORT, value);
 		}
 
 		//Retrieve host
@@ -1157,10 +1160,10 @@ bool NetworkManager::ExecuteNodeEntry(NodeEntry *entry, bool newEntry, int &erro
 				valueRegex.assign(PATTERN_HOST);
 				if(!boost::regex_match(host, valueRegex)) return false;
 			}
-			batch.Put(entry->GetNode()+NMDB_MASK_HOST, host);
+			batch.Put(family, entry->GetNode()+NMDB_MASK_HOST, host);
 		}
 		else {
-			status = db->Get(rocksdb::ReadOptions(), entry->GetNode()+NMDB_MASK_HOST, &host);
+			status = db->Get(rocksdb::ReadOptions(), family, entry->GetNode()+NMDB_MASK_HOST, &host);
 			if(status.IsNotFound()) return false;
 		}
 
@@ -1170,10 +1173,10 @@ bool NetworkManager::ExecuteNodeEntry(NodeEntry *entry, bool newEntry, int &erro
 				valueRegex.assign(PATTERN_NETWORK_VERSION);
 				if(!boost::regex_match(version, valueRegex)) return false;
 			}
-			batch.Put(entry->GetNode()+NMDB_MASK_VERSION, version);
+			batch.Put(family, entry->GetNode()+NMDB_MASK_VERSION, version);
 		}
 		else {
-			status = db->Get(rocksdb::ReadOptions(), entry->GetNode()+NMDB_MASK_VERSION, &version);
+			status = db->Get(rocksdb::ReadOptions(), family, entry->GetNode()+NMDB_MASK_VERSION, &version);
 			if(status.IsNotFound()) version = CURRENT_VERSION;
 		}
 
@@ -1183,25 +1186,27 @@ bool NetworkManager::ExecuteNodeEntry(NodeEntry *entry, bool newEntry, int &erro
 				valueRegex.assign(PATTERN_ACCOUNT);
 				if(!boost::regex_match(account, valueRegex)) return false;
 			}
-			batch.Put(entry->GetNode()+NMDB_MASK_ACCOUNT, account);
+			batch.Put(family, entry->GetNode()+NMDB_MASK_ACCOUNT, account);
 		}
 		else {
-			status = db->Get(rocksdb::ReadOptions(), entry->GetNode()+NMDB_MASK_ACCOUNT, &account);
+			status = db->Get(rocksdb::ReadOptions(), family, entry->GetNode()+NMDB_MASK_ACCOUNT, &account);
 			if(status.IsNotFound()) account = WORLD_BANK_NODE_ACCOUNT;
 		}
 
-		//Verify if it has a public key to register
-		if(entry->GetPublicKey(value) && !keysDB->SetPublicKey(entry->GetNode(), value, ID_TYPE_NODE)) return false;
-		else if(!keysDB->GetPublicKey(entry->GetNode(), publicKey, ID_TYPE_NODE, false)) return false;
+		//Verify if it has a public key to register, written along with the entry
+		bool NEW_KEY = entry->GetPublicKey(value);
+		if(NEW_KEY && !keysDB->SetPublicKey(batch, entry->GetNode(), value, publicKey, ID_TYPE_NODE)) return false;
+		else if(!NEW_KEY && !keysDB->GetPublicKey(entry->GetNode(), publicKey, ID_TYPE_NODE, false)) return false;
 
 		//Retrieve reputation if applicable
-		status = db->Get(rocksdb::ReadOptions(), entry->GetNode()+NMDB_MASK_REPUTATION, &value);
+		status = db->Get(rocksdb::ReadOptions(), family, entry->GetNode()+NMDB_MASK_REPUTATION, &value);
 		if(status.IsNotFound()) reputation = NODE_REPUTATION_DEFAULT;
 		else reputation = std::stol(value);
 
 		//Commit updates
 		status = db->Write(rocksdb::WriteOptions(), &batch);
 		if(!status.ok()) return false;
+		if(NEW_KEY) keysDB->Invalidate(entry->GetNode());
 
 		//Add the Validating Node to its manager
 		nodes->NewNode(entry->GetNode(), publicKey, host, version, account, reputation);
@@ -1220,14 +1225,14 @@ bool NetworkManager::ExecuteNodeEntry(NodeEntry *entry, bool newEntry, int &erro
 				valueRegex.assign(PATTERN_PASSPORT_ID);
 				if(!boost::regex_match(value, valueRegex)) return false;
 			}
-			batch.Put(entry->GetNode()+NMDB_MASK_PASSPORT, value);
+			batch.Put(family, entry->GetNode()+NMDB_MASK_PASSPORT, value);
 		}
 		if(entry->GetHost(value)) {
 			if(newEntry) {
 				valueRegex.assign(PATTERN_HOST);
 				if(!boost::regex_match(value, valueRegex)) return false;
 			}
-			batch.Put(entry->GetNode()+NMDB_MASK_HOST, value);
+			batch.Put(family, entry->GetNode()+NMDB_MASK_HOST, value);
 			//Update host directly into Nodes manager as well
 			nodes->SetHost(entry->GetNode(), value, newEntry);
 		}
@@ -1236,7 +1241,7 @@ bool NetworkManager::ExecuteNodeEntry(NodeEntry *entry, bool newEntry, int &erro
 				valueRegex.assign(PATTERN_NETWORK_VERSION);
 				if(!boost::regex_match(value, valueRegex)) return false;
 			}
-			batch.Put(entry->GetNode()+NMDB_MASK_VERSION, value);
+			batch.Put(family, entry->GetNode()+NMDB_MASK_VERSION, value);
 			//Update network version directly into Nodes manager as well
 			nodes->SetNetworkVersion(entry->GetNode(), value);
 		}
@@ -1245,19 +1250,23 @@ bool NetworkManager::ExecuteNodeEntry(NodeEntry *entry, bool newEntry, int &erro
 				valueRegex.assign(PATTERN_ACCOUNT);
 				if(!boost::regex_match(value, valueRegex)) return false;
 			}
-			batch.Put(entry->GetNode()+NMDB_MASK_ACCOUNT, value);
+			batch.Put(family, entry->GetNode()+NMDB_MASK_ACCOUNT, value);
 			//Update Node's account directly into the Nodes manager as well
 			nodes->SetAccount(entry->GetNode(), value);
 		}
 
+		//Verify if it has a public key to register
+		std::string publicKey, stored;
+		bool NEW_KEY = entry->GetPublicKey(publicKey);
+		if(NEW_KEY && !keysDB->SetPublicKey(batch, entry->GetNode(), publicKey, stored, ID_TYPE_NODE)) return false;
+
 		//Commit updates
 		status = db->Write(rocksdb::WriteOptions(), &batch);
 		if(!status.ok()) return false;
 
-		//Verify if it has a public key to register
-		if(entry->GetPublicKey(value)) {
-			if(!keysDB->SetPublicKey(entry->GetNode(), value, ID_TYPE_NODE)) return false;
-			nodes->SetPublicKey(entry->GetNode(), value);
+		if(NEW_KEY) {
+			keysDB->Invalidate(entry->GetNode());
+			nodes->SetPublicKey(entry->GetNode(), publicKey);
 		}
 	}
 
@@ -1270,12 +1279,12 @@ bool NetworkManager::ExecuteDAOEntry(DAOEntry *entry, bool newEntry, int &errorC
 	std::string key = NMB_RESOURCE_DAO+NMDB_MASK_DELIMITER+entry->GetDAO();
 
 	//If cancel, remove DAO ID
-	if(entry->GetType() == ENTRY_TYPE_CANCEL) db->Delete(rocksdb::WriteOptions(), key);
+	if(entry->GetType() == ENTRY_TYPE_CANCEL) db->Delete(rocksdb::WriteOptions(), family, key);
 
 	else {
 		if(entry->GetType() == ENTRY_TYPE_CREATE || entry->GetType() == ENTRY_TYPE_RENEW) {
 			//Keep DAO ID
-			status = db->Put(rocksdb::WriteOptions(), key, entry->GetDAO());
+			status = db->Put(rocksdb::WriteOptions(), family, key, entry->GetDAO());
 			if(!status.ok()) {
 				errorCode = ERROR_UNSUPPORTED;
 				return false;
@@ -1295,7 +1304,7 @@ bool NetworkManager::ExecuteDAOEntry(DAOEntry *entry, bool newEntry, int &errorC
 					return false;
 				}
 			}
-			batch.Put(entry->GetDAO()+NMDB_MASK_SUPERVISOR, value);
+			batch.Put(family, entry->GetDAO()+NMDB_MASK_SUPERVISOR, value);
 			//Update DAO's supervisor directly into the manager
 			managerDAO->SetSupervisor(entry->GetDAO(), value);
 		}
@@ -1307,7 +1316,7 @@ bool NetworkManager::ExecuteDAOEntry(DAOEntry *entry, bool newEntry, int &errorC
 					return false;
 				}
 			}
-			batch.Put(entry->GetDAO()+NMDB_MASK_VERSION, value);
+			batch.Put(family, entry->GetDAO()+NMDB_MASK_VERSION, value);
 			//Update network version directly into the DAO manager
 			managerDAO->SetVersion(entry->GetDAO(), value);
 		}
@@ -1319,7 +1328,7 @@ bool NetworkManager::ExecuteDAOEntry(DAOEntry *entry, bool newEntry, int &errorC
 					return false;
 				}
 			}
-			batch.Put(entry->GetDAO()+NMDB_MASK_ACCOUNT, value);
+			batch.Put(family, entry->GetDAO()+NMDB_MASK_ACCOUNT, value);
 			//Update the official account directly into the DAO manager
 			managerDAO->SetAccount(entry->GetDAO(), value);
 		}
@@ -1336,12 +1345,12 @@ bool NetworkManager::ExecuteDASEntry(DASEntry *entry, bool newEntry, int &errorC
 	std::string key = NMB_RESOURCE_DAS+NMDB_MASK_DELIMITER+entry->GetDAS();
 
 	//If cancel, remove DAS ID
-	if(entry->GetType() == ENTRY_TYPE_CANCEL) db->Delete(rocksdb::WriteOptions(), key);
+	if(entry->GetType() == ENTRY_TYPE_CANCEL) db->Delete(rocksdb::WriteOptions(), family, key);
 
 	else {
 		if(entry->GetType() == ENTRY_TYPE_CREATE || entry->GetType() == ENTRY_TYPE_RENEW) {
 			//Keep DAS ID
-			status = db->Put(rocksdb::WriteOptions(), key, entry->GetDAS());
+			status = db->Put(rocksdb::WriteOptions(), family, key, entry->GetDAS());
 			if(!status.ok()) {
 				errorCode = ERROR_UNSUPPORTED;
 				return false;
@@ -1361,7 +1370,7 @@ bool NetworkManager::ExecuteDASEntry(DASEntry *entry, bool newEntry, int &errorC
 					return false;
 				}
 			}
-			batch.Put(entry->GetDAS()+NMDB_MASK_MANAGER, value);
+			batch.Put(family, entry->GetDAS()+NMDB_MASK_MANAGER, value);
 			//Update DAS's manager directly into the manager
 			managerDAS->SetManager(entry->GetDAS(), value);
 		}
@@ -1373,7 +1382,7 @@ bool NetworkManager::ExecuteDASEntry(DASEntry *entry, bool newEntry, int &errorC
 					return false;
 				}
 			}
-			batch.Put(entry->GetDAS()+NMDB_MASK_VERSION, value);
+			batch.Put(family, entry->GetDAS()+NMDB_MASK_VERSION, value);
 			//Update network version directly into the DAS manager
 			managerDAS->SetVersion(entry->GetDAS(), value);
 		}
@@ -1385,7 +1394,7 @@ bool NetworkManager::ExecuteDASEntry(DASEntry *entry, bool newEntry, int &errorC
 					return false;
 				}
 			}
-			batch.Put(entry->GetDAS()+NMDB_MASK_ACCOUNT, value);
+			batch.Put(family, entry->GetDAS()+NMDB_MASK_ACCOUNT, value);
 			//Update the official account directly into the DAS manager
 			managerDAS->SetAccount(entry->GetDAS(), value);
 		}
@@ -1417,7 +1426,7 @@ bool NetworkManager::ExecuteSlotEntry(SlotEntry *entry, bool newEntry, int &erro
 	if(entry->GetType() == ENTRY_TYPE_CREATE) {
 		//Set start date
 		if(!entry->GetStart(timestamp)) timestamp = entry->GetTimestamp();
-		batch.Put(entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetManager()+NMDB_MASK_START, std::to_string(timestamp));
+		batch.Put(family, entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetManager()+NMDB_MASK_START, std::to_string(timestamp));
 
 		//Set activation
 		if(now >= timestamp && !slotsDB->SetEntity(entry->GetSlot(), entry->GetManager())) {
@@ -1428,7 +1437,7 @@ bool NetworkManager::ExecuteSlotEntry(SlotEntry *entry, bool newEntry, int &erro
 
 		//Set validity
 		if(entry->GetValidity(timestamp)) {
-			batch.Put(entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetManager()+NMDB_MASK_VALIDITY, std::to_string(timestamp));
+			batch.Put(family, entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetManager()+NMDB_MASK_VALIDITY, std::to_string(timestamp));
 			slotsExpiration[timestamp].push_back(std::make_pair(entry->GetSlot(), entry->GetManager()));
 		}
 		return true;
@@ -1443,25 +1452,25 @@ bool NetworkManager::ExecuteSlotEntry(SlotEntry *entry, bool newEntry, int &erro
 		}
 
 		//Remove subleases
-		batch.Delete(entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetSigner()+NMDB_MASK_SUPERVISING);
-		status = db->Get(rocksdb::ReadOptions(), entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetSigner()+NMDB_MASK_SUPERVISING, &next);
+		batch.Delete(family, entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetSigner()+NMDB_MASK_SUPERVISING);
+		status = db->Get(rocksdb::ReadOptions(), family, entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetSigner()+NMDB_MASK_SUPERVISING, &next);
 		while(!status.IsNotFound()) {
 			//delete data
-			batch.Delete(entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_START);
-			batch.Delete(entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_VALIDITY);
-			batch.Delete(entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_SUPERVISOR);
-			batch.Delete(entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_SUPERVISING);
+			batch.Delete(family, entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_START);
+			batch.Delete(family, entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_VALIDITY);
+			batch.Delete(family, entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_SUPERVISOR);
+			batch.Delete(family, entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_SUPERVISING);
 
 			//Retrieve start date and remove from activation list
-			status = db->Get(rocksdb::ReadOptions(), entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_START, &value);
+			status = db->Get(rocksdb::ReadOptions(), family, entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_START, &value);
 			if(!status.IsNotFound() && std::stoul(value) >= now) RemoveSlotUpdate(std::stoul(value), entry->GetSlot(), entry->GetManager());
 
 			//Retrieve validity and remove from deactivation list
-			status = db->Get(rocksdb::ReadOptions(), entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_VALIDITY, &value);
+			status = db->Get(rocksdb::ReadOptions(), family, entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_VALIDITY, &value);
 			if(!status.IsNotFound()) RemoveSlotUpdate(std::stoul(value), entry->GetSlot(), entry->GetManager(), false);
 
 			//fetch next entity
-			status = db->Get(rocksdb::ReadOptions(), entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_SUPERVISING, &next);
+			status = db->Get(rocksdb::ReadOptions(), family, entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_SUPERVISING, &next);
 		}
 	}
 
@@ -1471,17 +1480,17 @@ bool NetworkManager::ExecuteSlotEntry(SlotEntry *entry, bool newEntry, int &erro
 		//Update validity
 		if(entry->GetValidity(timestamp)) {
 			//Retrieve current validity
-			status = db->Get(rocksdb::ReadOptions(), entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetManager()+NMDB_MASK_VALIDITY, &value);
+			status = db->Get(rocksdb::ReadOptions(), family, entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetManager()+NMDB_MASK_VALIDITY, &value);
 			//remove from deactivation list
 			if(!status.IsNotFound()) RemoveSlotUpdate(std::stoul(value), entry->GetSlot(), entry->GetManager(), false);
 
 			//set new validity
-			batch.Put(entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetManager()+NMDB_MASK_VALIDITY, std::to_string(timestamp));
+			batch.Put(family, entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetManager()+NMDB_MASK_VALIDITY, std::to_string(timestamp));
 			slotsExpiration[timestamp].push_back(std::make_pair(entry->GetSlot(), entry->GetManager()));
 		}
 		else {
 			//retrieve manager's current start date
-			status = db->Get(rocksdb::ReadOptions(), entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetManager()+NMDB_MASK_START, &value);
+			status = db->Get(rocksdb::ReadOptions(), family, entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetManager()+NMDB_MASK_START, &value);
 			if(!status.IsNotFound()) startDate = std::stoul(value);
 
 			//Update start date
@@ -1490,7 +1499,7 @@ bool NetworkManager::ExecuteSlotEntry(SlotEntry *entry, bool newEntry, int &erro
 				if(startDate > 0) RemoveSlotUpdate(startDate, entry->GetSlot(), entry->GetManager());
 
 				//set new start date
-				batch.Put(entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetManager()+NMDB_MASK_START, std::to_string(timestamp));
+				batch.Put(family, entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetManager()+NMDB_MASK_START, std::to_string(timestamp));
 				//and activation
 				if(now >= timestamp && !slotsDB->SetEntity(entry->GetSlot(), entry->GetManager())) {
 					errorCode = ERROR_DATA_CONTENT;
@@ -1520,33 +1529,33 @@ bool NetworkManager::ExecuteSlotEntry(SlotEntry *entry, bool newEntry, int &erro
 	//Update type
 	else {
 		//Remove subleases
-		batch.Delete(entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetSigner()+NMDB_MASK_SUPERVISING);
-		status = db->Get(rocksdb::ReadOptions(), entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetSigner()+NMDB_MASK_SUPERVISING, &next);
+		batch.Delete(family, entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetSigner()+NMDB_MASK_SUPERVISING);
+		status = db->Get(rocksdb::ReadOptions(), family, entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetSigner()+NMDB_MASK_SUPERVISING, &next);
 		while(!status.IsNotFound()) {
 			//delete data
-			batch.Delete(entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_START);
-			batch.Delete(entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_VALIDITY);
-			batch.Delete(entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_SUPERVISOR);
-			batch.Delete(entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_SUPERVISING);
+			batch.Delete(family, entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_START);
+			batch.Delete(family, entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_VALIDITY);
+			batch.Delete(family, entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_SUPERVISOR);
+			batch.Delete(family, entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_SUPERVISING);
 
 			//Retrieve start date and remove from activation list
-			status = db->Get(rocksdb::ReadOptions(), entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_START, &value);
+			status = db->Get(rocksdb::ReadOptions(), family, entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_START, &value);
 			if(!status.IsNotFound() && std::stoul(value) >= now) RemoveSlotUpdate(std::stoul(value), entry->GetSlot(), entry->GetManager());
 
 			//Retrieve validity and remove from deactivation list
-			status = db->Get(rocksdb::ReadOptions(), entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_VALIDITY, &value);
+			status = db->Get(rocksdb::ReadOptions(), family, entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_VALIDITY, &value);
 			if(!status.IsNotFound()) RemoveSlotUpdate(std::stoul(value), entry->GetSlot(), entry->GetManager(), false);
 
 			//fetch next entity
-			status = db->Get(rocksdb::ReadOptions(), entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_SUPERVISING, &next);
+			status = db->Get(rocksdb::ReadOptions(), family, entry->GetSlot()+NMDB_MASK_DELIMITER+next+NMDB_MASK_SUPERVISING, &next);
 		}
 
 		//Update link
-		batch.Put(entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetSigner()+NMDB_MASK_SUPERVISING, entry->GetManager());
+		batch.Put(family, entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetSigner()+NMDB_MASK_SUPERVISING, entry->GetManager());
 		
 		//Retrieve effective date
 		if(!entry->GetStart(timestamp)) timestamp = entry->GetTimestamp();
-		batch.Put(entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetSigner()+NMDB_MASK_START, std::to_string(timestamp));
+		batch.Put(family, entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetSigner()+NMDB_MASK_START, std::to_string(timestamp));
 
 		//Check date
 		if(now >= timestamp) {
@@ -1562,14 +1571,14 @@ bool NetworkManager::ExecuteSlotEntry(SlotEntry *entry, bool newEntry, int &erro
 		//Set validity, if speficied
 		if(entry->GetValidity(timestamp)) {
 			slotsExpiration[timestamp].push_back(std::make_pair(entry->GetSlot(), entry->GetSigner()));
-			batch.Put(entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetSigner()+NMDB_MASK_VALIDITY, std::to_string(timestamp));
+			batch.Put(family, entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetSigner()+NMDB_MASK_VALIDITY, std::to_string(timestamp));
 		}
 		else {
 			//or retrieve from signer's
-			status = db->Get(rocksdb::ReadOptions(), entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetSigner()+NMDB_MASK_SUPERVISING, &value);
+			status = db->Get(rocksdb::ReadOptions(), family, entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetSigner()+NMDB_MASK_SUPERVISING, &value);
 			if(!status.IsNotFound()) {
 				slotsExpiration[std::stoul(value)].push_back(std::make_pair(entry->GetSlot(), entry->GetSigner()));
-				batch.Put(entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetSigner()+NMDB_MASK_VALIDITY, value);
+				batch.Put(family, entry->GetSlot()+NMDB_MASK_DELIMITER+entry->GetSigner()+NMDB_MASK_VALIDITY, value);
 			}
 		}
 	}
@@ -1605,20 +1614,20 @@ bool NetworkManager::ExecuteSlotTransfer(SlotTransfer transfer) {
 	std::string value;
 	
 	//Set manager's start date equal to the signer's
-	status = db->Get(rocksdb::ReadOptions(), transfer.slot+NMDB_MASK_DELIMITER+transfer.from+NMDB_MASK_START, &value);
+	status = db->Get(rocksdb::ReadOptions(), family, transfer.slot+NMDB_MASK_DELIMITER+transfer.from+NMDB_MASK_START, &value);
 	if(status.IsNotFound()) return false;
-	batch.Put(transfer.slot+NMDB_MASK_DELIMITER+transfer.to+NMDB_MASK_START, value);
+	batch.Put(family, transfer.slot+NMDB_MASK_DELIMITER+transfer.to+NMDB_MASK_START, value);
 
 	//Set manager's validity equal to the signer's 
-	status = db->Get(rocksdb::ReadOptions(), transfer.slot+NMDB_MASK_DELIMITER+transfer.from+NMDB_MASK_VALIDITY, &value);
-	if(!status.IsNotFound()) batch.Put(transfer.slot+NMDB_MASK_DELIMITER+transfer.to+NMDB_MASK_VALIDITY, value);
+	status = db->Get(rocksdb::ReadOptions(), family, transfer.slot+NMDB_MASK_DELIMITER+transfer.from+NMDB_MASK_VALIDITY, &value);
+	if(!status.IsNotFound()) batch.Put(family, transfer.slot+NMDB_MASK_DELIMITER+transfer.to+NMDB_MASK_VALIDITY, value);
 
-	status = db->Get(rocksdb::ReadOptions(), transfer.slot+NMDB_MASK_DELIMITER+transfer.from+NMDB_MASK_SUPERVISOR, &value);
+	status = db->Get(rocksdb::ReadOptions(), family, transfer.slot+NMDB_MASK_DELIMITER+transfer.from+NMDB_MASK_SUPERVISOR, &value);
 	if(!status.IsNotFound()) {
 		//Keep signer's supervisor as the manager's supervisor
-		batch.Put(transfer.slot+NMDB_MASK_DELIMITER+transfer.to+NMDB_MASK_SUPERVISOR, value);
+		batch.Put(family, transfer.slot+NMDB_MASK_DELIMITER+transfer.to+NMDB_MASK_SUPERVISOR, value);
 		//Link the manager with this supervisor
-		batch.Put(transfer.slot+NMDB_MASK_DELIMITER+value+NMDB_MASK_SUPERVISOR, transfer.to);
+		batch.Put(family, transfer.slot+NMDB_MASK_DELIMITER+value+NMDB_MASK_SUPERVISOR, transfer.to);
 	}
 
 	//retrieve Slot's current manager
@@ -1628,10 +1637,10 @@ bool NetworkManager::ExecuteSlotTransfer(SlotTransfer transfer) {
 	if(transfer.from == manager && !slotsDB->SetEntity(transfer.slot, transfer.to)) return false;
 
 	//Remove signer's data
-	batch.Delete(transfer.slot+NMDB_MASK_DELIMITER+transfer.from+NMDB_MASK_START);
-	batch.Delete(transfer.slot+NMDB_MASK_DELIMITER+transfer.from+NMDB_MASK_VALIDITY);
-	batch.Delete(transfer.slot+NMDB_MASK_DELIMITER+transfer.from+NMDB_MASK_SUPERVISOR);
-	batch.Delete(transfer.slot+NMDB_MASK_DELIMITER+transfer.from+NMDB_MASK_SUPERVISING);
+	batch.Delete(family, transfer.slot+NMDB_MASK_DELIMITER+transfer.from+NMDB_MASK_START);
+	batch.Delete(family, transfer.slot+NMDB_MASK_DELIMITER+transfer.from+NMDB_MASK_VALIDITY);
+	batch.Delete(family, transfer.slot+NMDB_MASK_DELIMITER+transfer.from+NMDB_MASK_SUPERVISOR);
+	batch.Delete(family, transfer.slot+NMDB_MASK_DELIMITER+transfer.from+NMDB_MASK_SUPERVISING);
 
 	//Execute changes
 	status = db->Write(rocksdb::WriteOptions(), &batch);
@@ -1717,30 +1726,30 @@ bool NetworkManager::RequestBlock(std::vector<std::string> peers, std::string ha
 
 void NetworkManager::NewBlock(uint id, std::string hash) {
 	std::string value;
-	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), NMDB_MASK_BLOCK+hash, &value);
-	rocksdb::Status status2 = db->Get(rocksdb::ReadOptions(), NMDB_MASK_BLOCK+std::to_string(id), &value);
+	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), family, NMDB_MASK_BLOCK+hash, &value);
+	rocksdb::Status status2 = db->Get(rocksdb::ReadOptions(), family, NMDB_MASK_BLOCK+std::to_string(id), &value);
 
 	//Ensure no other block with that hash has already been submitted
 	if(status.IsNotFound()) {
 		rocksdb::WriteBatch batch;
-		status = db->Get(rocksdb::ReadOptions(), NMDB_MASK_BLOCK+std::to_string((id-1)), &value);
+		status = db->Get(rocksdb::ReadOptions(), family, NMDB_MASK_BLOCK+std::to_string((id-1)), &value);
 		//correctly link the Block it with the rest of the chain
 		if(!status.IsNotFound()) {
-			batch.Put(NMDB_MASK_BLOCK+value+NMDB_MASK_NEXT, hash);
-			batch.Put(NMDB_MASK_BLOCK+hash+NMDB_MASK_PREVIOUS, value);
+			batch.Put(family, NMDB_MASK_BLOCK+value+NMDB_MASK_NEXT, hash);
+			batch.Put(family, NMDB_MASK_BLOCK+hash+NMDB_MASK_PREVIOUS, value);
 		}
 
 		//Check if it's the latest closed Block
-		status = db->Get(rocksdb::ReadOptions(), NMDB_MASK_BLOCK+hash+NMDB_MASK_NEXT, &value);
+		status = db->Get(rocksdb::ReadOptions(), family, NMDB_MASK_BLOCK+hash+NMDB_MASK_NEXT, &value);
 		if(status.IsNotFound() || status2.IsNotFound()) latestBlock = hash;
 
-		batch.Put(NMDB_MASK_BLOCK+std::to_string(id), hash);
-		batch.Put(NMDB_MASK_BLOCK+hash, std::to_string(id));
+		batch.Put(family, NMDB_MASK_BLOCK+std::to_string(id), hash);
+		batch.Put(family, NMDB_MASK_BLOCK+hash, std::to_string(id));
 
 		uint closing = GENESIS_BLOCK_END + (id * BLOCK_DURATION);
 		uint opening = closing - BLOCK_DURATION + 1;
-		batch.Put(NMDB_MASK_BLOCK+hash+NMDB_MASK_CLOSE, std::to_string(closing));
-		batch.Put(NMDB_MASK_BLOCK+hash+NMDB_MASK_OPEN, std::to_string(opening));
+		batch.Put(family, NMDB_MASK_BLOCK+hash+NMDB_MASK_CLOSE, std::to_string(closing));
+		batch.Put(family, NMDB_MASK_BLOCK+hash+NMDB_MASK_OPEN, std::to_string(opening));
 
 		//Comming updates and persist to local index file
 		db->Write(rocksdb::WriteOptions(), &batch);
@@ -1750,7 +1759,7 @@ void NetworkManager::NewBlock(uint id, std::string hash) {
 
 bool NetworkManager::GetBlock(std::string hash, std::string &blockFile) {
 	std::string id;
-	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), NMDB_MASK_BLOCK+hash, &id);
+	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), family, NMDB_MASK_BLOCK+hash, &id);
 
 	if(status.IsNotFound()) return false;
 	blockFile = LOCAL_DATA_BLOCKS + id + BLOCK_EXTENSION;
@@ -1766,7 +1775,7 @@ bool NetworkManager::SetBlock(std::string blockFile) {
 		return false;
 	}
 
-	std::set<std::string> entriesList;
+	std::vector<Hash160> entriesList;
 	std::string value, hash, blockHash, previousHash, entriesRoot;
 	uint id;
 	char c;
@@ -1818,7 +1827,12 @@ bool NetworkManager::SetBlock(std::string blockFile) {
 		//get hash
 		in.read(&buffer.front(), ENTRY_HASH_LENGTH);
 		value = Util::array_to_string(buffer, ENTRY_HASH_LENGTH, 0);
-		entriesList.insert(value);
+		entriesList.emplace_back();
+		if(!Hash160::FromHex(value, entriesList.back())) {
+			in.close();
+			FailedToFetch(blockHash);
+			return false;
+		}
 
 		//skip its contents
 		in.seekg(3, std::ios_base::cur);
@@ -1840,6 +1854,7 @@ bool NetworkManager::SetBlock(std::string blockFile) {
 	in.close();
 
 	//Compute the Entries Merkle tree root and compare it with the one stated
+	Hash160::SortUnique(entriesList);
 	if(entriesRoot != Crypto::MerkleRoot(entriesList)) {
 		FailedToFetch(blockHash);
 		return false;
@@ -1863,7 +1878,7 @@ void NetworkManager::ExecuteBlock(std::string newBlock, bool latest) {
 	buffer.resize(STANDARD_HASH_LENGTH);
 
 	//Retrieve Entries already executed
-	std::set<std::string> oldEntries;
+	std::vector<Hash160> oldEntries;
 	if(block->IS_SYNCHRONIZED && latest) oldEntries = block->GetLatestEntries();
 
 	std::fstream in(newBlock, std::fstream::in);
@@ -1871,7 +1886,8 @@ void NetworkManager::ExecuteBlock(std::string newBlock, bool latest) {
 	in.seekg(200, std::ios_base::beg);
 	while(c != '{') in.get(c);
 
-	//Read and execute all missing Entries
+	//Read all missing Entries, their signatures are checked together before any is executed
+	std::vector<Entry*> entries;
 	int count, errorCode;
 	bool outside;
 	while(c != '}') {
@@ -1885,9 +1901,9 @@ void NetworkManager::ExecuteBlock(std::string newBlock, bool latest) {
 		count = 1;
 		outside = true;
 
-		//Verify if it's missing
-		auto it = oldEntries.find(hash);
-		if(it != oldEntries.end()) {
+		//Verify if it's missing, the Merkle root was checked against decoded hashes only
+		Hash160 id;
+		if(!Hash160::FromHex(hash, id) || Hash160::Contains(oldEntries, id)) {
 			//skip its contents
 			while(count > 0) {
 				in.get(c);
@@ -1914,17 +1930,47 @@ void NetworkManager::ExecuteBlock(std::string newBlock, bool latest) {
 				content += c;
 			}
 
-			//Execute Entry if it is valid
+			//Keep Entry if it is valid
 			entry = Processing::CreateEntry(content, errorCode);
-			if(errorCode == VALID && hash == entry->GetHash()) ExecuteEntry(entry, false, errorCode);
-
-			delete entry;
+			if(errorCode == VALID && hash == entry->GetHash()) entries.push_back(entry);
+			else delete entry;
 		}
 
 		//read separation comma or transactions array's end bracket
 		in.get(c);
 	}
 	in.close();
+
+	//Verify every Entry whose signer is already known as one batch
+	std::vector<std::string> signatures(entries.size());
+	std::vector<SignatureStruct> batch;
+	std::vector<int> position(entries.size(), -1);
+	for(size_t i = 0; i < entries.size(); i++) {
+		SignatureStruct item;
+		int idType = Processing::GetIdType(entries[i]->GetSigner());
+		if(!idType || !keysDB->GetPublicKey(entries[i]->GetSigner(), item, idType)) continue;
+
+		signatures[i] = entries[i]->GetSignature();
+		item.message = entries[i]->GetHash();
+		item.signature = {signatures[i].data(), signatures[i].length()};
+		position[i] = batch.size();
+		batch.push_back(item);
+	}
+	Crypto::VerifyBatch(batch);
+
+	//Execute them in order, a signer registered by an earlier Entry of this Block is checked on its own
+	for(size_t i = 0; i < entries.size(); i++) {
+		bool valid;
+		if(position[i] >= 0) valid = batch[position[i]].valid;
+		else {
+			std::string publicKey;
+			int idType = Processing::GetIdType(entries[i]->GetSigner());
+			valid = idType && keysDB->GetPublicKey(entries[i]->GetSigner(), publicKey, idType) && Crypto::Verify(entries[i]->GetHash(), entries[i]->GetSignature(), publicKey);
+		}
+		if(valid) ExecuteEntry(entries[i], false, errorCode);
+
+		delete entries[i];
+	}
 }
 
 void NetworkManager::FailedToFetch(std::string hash /*=""*/) {
@@ -1990,30 +2036,30 @@ void NetworkManager::FailedToFetch(std::string hash /*=""*/) {
 
 void NetworkManager::NewLedger(uint id, std::string hash) {
 	std::string value;
-	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), NMDB_MASK_LEDGER+hash, &value);
-	rocksdb::Status status2 = db->Get(rocksdb::ReadOptions(), NMDB_MASK_LEDGER+std::to_string(id), &value);
+	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), family, NMDB_MASK_LEDGER+hash, &value);
+	rocksdb::Status status2 = db->Get(rocksdb::ReadOptions(), family, NMDB_MASK_LEDGER+std::to_string(id), &value);
 
 	//Ensure no other Ledger with that hash has already been submitted
 	if(status.IsNotFound()) {
 		rocksdb::WriteBatch batch;
-		status = db->Get(rocksdb::ReadOptions(), NMDB_MASK_LEDGER+std::to_string((id-1)), &value);
+		status = db->Get(rocksdb::ReadOptions(), family, NMDB_MASK_LEDGER+std::to_string((id-1)), &value);
 		//correctly link the Ledger with the rest of the chain
 		if(!status.IsNotFound()) {
-			batch.Put(NMDB_MASK_LEDGER+value+NMDB_MASK_NEXT, hash);
-			batch.Put(NMDB_MASK_LEDGER+hash+NMDB_MASK_PREVIOUS, value);
+			batch.Put(family, NMDB_MASK_LEDGER+value+NMDB_MASK_NEXT, hash);
+			batch.Put(family, NMDB_MASK_LEDGER+hash+NMDB_MASK_PREVIOUS, value);
 		}
 
 		//Check if it's the latest closed Ledger
-		status = db->Get(rocksdb::ReadOptions(), NMDB_MASK_LEDGER+hash+NMDB_MASK_NEXT, &value);
+		status = db->Get(rocksdb::ReadOptions(), family, NMDB_MASK_LEDGER+hash+NMDB_MASK_NEXT, &value);
 		if(status.IsNotFound() || status2.IsNotFound()) latestLedger = hash;
 
-		batch.Put(NMDB_MASK_LEDGER+std::to_string(id), hash);
-		batch.Put(NMDB_MASK_LEDGER+hash, std::to_string(id));
+		batch.Put(family, NMDB_MASK_LEDGER+std::to_string(id), hash);
+		batch.Put(family, NMDB_MASK_LEDGER+hash, std::to_string(id));
 
 		uint closing = GENESIS_LEDGER_END + (id * LEDGER_DURATION);
 		uint opening = closing - LEDGER_DURATION + 1;
-		batch.Put(NMDB_MASK_LEDGER+hash+NMDB_MASK_CLOSE, std::to_string(closing));
-		batch.Put(NMDB_MASK_LEDGER+hash+NMDB_MASK_OPEN, std::to_string(opening));
+		batch.Put(family, NMDB_MASK_LEDGER+hash+NMDB_MASK_CLOSE, std::to_string(closing));
+		batch.Put(family, NMDB_MASK_LEDGER+hash+NMDB_MASK_OPEN, std::to_string(opening));
 
 		//Comming updates and persist to local index file
 		db->Write(rocksdb::WriteOptions(), &batch);
@@ -2023,7 +2069,7 @@ void NetworkManager::NewLedger(uint id, std::string hash) {
 
 bool NetworkManager::GetLedgerId(std::string hash, uint &id) {
 	std::string value;
-	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), NMDB_MASK_LEDGER+hash, &value);
+	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), family, NMDB_MASK_LEDGER+hash, &value);
 	if(status.IsNotFound()) return false;
 
 	id = std::stoul(value);
@@ -83,7 +83,7 @@ struct SlotTransfer {
 class NetworkManager {
 
 	public:
-		NetworkManager(rocksdb::DB *db, DAOManager *managerDAO, DASManager *managerDAS, Keys *keysDB, Publisher *publisher, Slots *slotsDB, ThreadsManager *threadsManager);
+		NetworkManager(rocksdb::DB *db, rocksdb::ColumnFamilyHandle *family, DAOManager *managerDAO, DASManager *managerDAS, Keys *keysDB, Publisher *publisher, Slots *slotsDB, ThreadsManager *threadsManager);
 
 		void SynchronizeNMB();
 		Ledger* SynchronizeLedgers(Balances *balancesDB, TransactionsManager *txManager);
@@ -140,6 +140,7 @@ class NetworkManager {
 		std::mutex dataMutex;
 
 		rocksdb::DB *db;
+		rocksdb::ColumnFamilyHandle *family;
 		Block *block;
 		DAOManager *managerDAO;
 		DASManager *managerDAS;
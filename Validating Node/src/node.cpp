@@ -57,6 +57,9 @@
 #include "globals.h"
 #include "codes.h"
 #include "communication.h"
+#include "ecdsa.h"
+#include "hash160.h"
+#include "stats.h"
 #include "threads_manager.h"
 #include "transaction.h"
 #include "util.h"
@@ -67,6 +70,9 @@ Nodes::Nodes(std::unordered_map<std::string, NodeStruct> nodesData) : nodesData(
 }
 
 void Nodes::Stop() {
+	//Don't drop confirmations still waiting for their batch
+	FlushConfirmations();
+
 	std::lock_guard<std::mutex> lock(dataMutex);
 
 	for(auto it = activeNodes.begin(); it != activeNodes.end(); ++it) {
@@ -312,7 +318,7 @@ int Nodes::ConfirmationThreshold(bool transaction /*=true*/) {
 bool Nodes::BroadcastNewTransaction(Transaction *Tx) {
 	std::vector<std::string> goodNodes, badNodes;
 	int counter = 0, threshold = ConfirmationThreshold();
-	std::string rawTx = Tx->GetTransaction();
+	const std::string &rawTx = Tx->GetTransaction();
 
 	//sort active nodes by reputation
 	for(auto it = nodesData.begin(); it != nodesData.end(); ++it) {
@@ -361,6 +367,8 @@ bool Nodes::BroadcastConfirmation(std::string hash, int confirmationType /*=CONF
 		default:return false;
 	}
 
+	//connections may be opened or dropped meanwhile
+	std::lock_guard<std::mutex> lock(dataMutex);
 	for(auto it = activeNodes.begin(); it != activeNodes.end(); ++it) {
 		if(Network::WriteMessage(*it->second, protocolCode, hash, true)) counter++; 
 	}
@@ -368,6 +376,53 @@ bool Nodes::BroadcastConfirmation(std::string hash, int confirmationType /*=CONF
 	return (counter > 0);
 }
 
+void Nodes::QueueConfirmation(const Hash160 &hash, bool MEASURED /*=false*/) {
+	bool full;
+
+	confirmationsMutex.lock();
+	pendingConfirmations.append(reinterpret_cast<const char*>(hash.bytes), HASH160_LENGTH);
+	if(MEASURED) pendingQueued.push_back(Util::current_timestamp_nanos());
+	full = (++pendingCount >= NODE_CONFIRMATIONS_BATCH);
+	confirmationsMutex.unlock();
+
+	//Don't wait for the timer once the batch is full
+	if(full) FlushConfirmations();
+}
+
+void Nodes::FlushConfirmations() {
+	std::string hashes;
+	std::vector<uint64_t> queued;
+	uint count;
+
+	confirmationsMutex.lock();
+	count = pendingCount;
+	hashes.swap(pendingConfirmations);
+	queued.swap(pendingQueued);
+	pendingCount = 0;
+	confirmationsMutex.unlock();
+
+	if(!count) return;
+
+	//number of hashes followed by the binary hashes
+	std::vector<char> header;
+	Util::int_to_array(count, NETWORK_CONFIRMATIONS_LENGTH, 0, header);
+	std::string content(header.begin(), header.end());
+	content += hashes;
+
+	//A single signature covers the whole batch for every peer
+	std::string signature(Crypto::Sign(content));
+
+	//sent every few milliseconds while connections are opened and dropped, keep them in place
+	std::lock_guard<std::mutex> lock(dataMutex);
+	for(auto it = activeNodes.begin(); it != activeNodes.end(); ++it) {
+		Network::WriteSignedMessage(*it->second, NETWORK_BROADCAST_CONFIRMATIONS, content, signature);
+	}
+
+	//Broadcast latency includes the time spent waiting for the batch
+	uint64_t sent = Util::current_timestamp_nanos();
+	for(auto it = queued.begin(); it != queued.end(); ++it) Stats::Record(STAGE_BROADCAST, sent - *it);
+}
+
 void Nodes::BroadcastEntry(std::string entry) {
 	for(auto it = activeNodes.begin(); it != activeNodes.end(); ++it) {
 		Network::WriteMessage(*it->second, NETWORK_NEW_ENTRY, entry, true); 
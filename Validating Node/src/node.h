@@ -47,6 +47,7 @@
 
 #include "globals.h"
 
+class Hash160;
 class ThreadsManager;
 class Transaction;
 
@@ -91,6 +92,8 @@ class Nodes {
 
 		bool BroadcastNewTransaction(Transaction *Tx);
 		bool BroadcastConfirmation(std::string hash, int confirmationType=CONFIRMATION_TRANSACTION);
+		void QueueConfirmation(const Hash160 &hash, bool MEASURED=false);
+		void FlushConfirmations();
 		void BroadcastEntry(std::string entry);
 		boost::asio::ip::tcp::socket* WriteToNode(std::string nodeId, int &errorCode);
 		boost::asio::ip::tcp::socket* WriteToRandomNode();
@@ -104,6 +107,12 @@ class Nodes {
 		std::unordered_map<std::string, boost::asio::ip::tcp::socket*> activeNodes;
 		std::unordered_map<std::string, int> retries;
 
+		//Transaction confirmations waiting to be sent as a single signed batch
+		std::mutex confirmationsMutex;
+		std::string pendingConfirmations;
+		uint pendingCount = 0;
+		std::vector<uint64_t> pendingQueued; //when each measured confirmation was queued
+
 		int broadcastNumber;
 		int confirmationThresholdTx;
 		int confirmationThresholdLedger;
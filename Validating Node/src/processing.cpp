@@ -35,9 +35,12 @@
  * UDC Validating Node.
  */
 
+#include <memory>
 #include <sstream>
+#include <vector>
 
 #include "includes/boost/regex.hpp"
+#include "includes/rapidjson/document.h"
 
 #include "balances.h"
 #include "codes.h"
@@ -58,6 +61,7 @@
 #include "modules_interface.h"
 #include "processing.h"
 #include "transaction.h"
+#include "transaction_arena.h"
 #include "transaction_basic.h"
 #include "transaction_delayed.h"
 #include "transaction_future.h"
@@ -66,38 +70,40 @@
 
 
 Transaction* Processing::CreateTransaction(DAOManager *managerDAO, DASManager *managerDAS, std::string &rawTx, int &errorCode) {
-	Transaction *transaction = new Transaction(rawTx.c_str());
+	Transaction *transaction = NULL;
 	std::string event;
 	errorCode = VALID;
 
-	//Step 1: check if the data corresponds to a generic transaction
-	if(!transaction->IsTransaction()) {
+	//Step 1: parse it once, straight into the arena the transaction will keep
+	std::shared_ptr<TransactionArena> arena = TransactionArena::Current();
+	rapidjson::Document document(&arena->allocator);
+	document.Parse(rawTx.c_str());
+
+	//Step 2: check if the data corresponds to a generic transaction
+	if(!document.IsObject() || !document.HasMember("type") || !document["type"].IsString()) {
 		errorCode = ERROR_TRANSACTION_INVALID;
-		delete transaction;
 		return NULL;
 	}
-	int type = std::stoul(transaction->GetType(),nullptr,16);
-	delete transaction;
+	int type = std::stoul(document["type"].GetString(),nullptr,16);
+
+	//Delayed and Future transactions are further specified by their event
+	if(type == TRANSACTION_DELAYED || type == TRANSACTION_FUTURE) {
+		if(!document.HasMember("event") || !document["event"].IsString()) {
+			errorCode = ERROR_TRANSACTION_INVALID;
+			return NULL;
+		}
+		event = document["event"].GetString();
+	}
 
-	//Step 2: find which transaction type-event it pertains to
+	//Step 3: hand the document over to the class of its type-event
 	switch(type) {
 		case TRANSACTION_BASIC:
-			transaction = new BasicTransaction(rawTx.c_str());
+			transaction = new BasicTransaction(document, arena);
 			break;
 
 		case TRANSACTION_DELAYED:
-			transaction = new DelayedTransaction(rawTx.c_str());
-			if(!transaction->IsTransaction()) {
-				errorCode = ERROR_TRANSACTION_INVALID;
-				delete transaction;
-				return NULL;
-			}
-			event = dynamic_cast<DelayedTransaction*>(transaction)->GetEvent();
-			delete transaction;
-
-			//Verify Delayed transaction event
-			if(event == TX_DELAYED_REQUEST) transaction = new RequestDelayedTransaction(rawTx.c_str());
-			if(event == TX_DELAYED_RELEASE) transaction = new ReleaseDelayedTransaction(rawTx.c_str());
+			if(event == TX_DELAYED_REQUEST) transaction = new RequestDelayedTransaction(document, arena);
+			else if(event == TX_DELAYED_RELEASE) transaction = new ReleaseDelayedTransaction(document, arena);
 			else {
 				errorCode = ERROR_UNSUPPORTED_EVENT;
 				return NULL;
@@ -105,18 +111,8 @@ Transaction* Processing::CreateTransaction(DAOManager *managerDAO, DASManager *m
 			break;
 
 		case TRANSACTION_FUTURE:
-			transaction = new FutureTransaction(rawTx.c_str());
-			if(!transaction->IsTransaction()) {
-				errorCode = ERROR_TRANSACTION_INVALID;
-				delete transaction;
-				return NULL;
-			}
-			event = dynamic_cast<FutureTransaction*>(transaction)->GetEvent();
-			delete transaction;
-
-			//Verify Future transaction event
-			if(event == TX_FUTURE_AUTHORIZE) transaction = new AuthorizeFutureTransaction(rawTx.c_str());
-			if(event == TX_FUTURE_EXECUTE) transaction = new ExecuteFutureTransaction(rawTx.c_str());
+			if(event == TX_FUTURE_AUTHORIZE) transaction = new AuthorizeFutureTransaction(document, arena);
+			else if(event == TX_FUTURE_EXECUTE) transaction = new ExecuteFutureTransaction(document, arena);
 			else {
 				errorCode = ERROR_UNSUPPORTED_EVENT;
 				return NULL;
@@ -124,11 +120,11 @@ Transaction* Processing::CreateTransaction(DAOManager *managerDAO, DASManager *m
 			break;
 
 		case TRANSACTION_DAO:
-			transaction = managerDAO->Create(rawTx, errorCode);
+			transaction = managerDAO->Create(rawTx, document, arena, errorCode);
 			break;
 
 		case TRANSACTION_DAS:
-			transaction = managerDAS->Create(rawTx, errorCode);
+			transaction = managerDAS->Create(rawTx, document, arena, errorCode);
 			break;
 
 		default:
@@ -138,7 +134,8 @@ Transaction* Processing::CreateTransaction(DAOManager *managerDAO, DASManager *m
 			break;
 	}
 	//discard if reached an error
-	if (errorCode != VALID) {
+	if (errorCode != VALID || !transaction) {
+		if(errorCode == VALID) errorCode = ERROR_TRANSACTION_INVALID;
 		delete transaction;
 		return NULL;
 	}
@@ -154,6 +151,9 @@ Transaction* Processing::CreateTransaction(DAOManager *managerDAO, DASManager *m
 	transaction->OrderData();
 	transaction->MakeHash();
 
+	//Requests, authorizations and modules' transactions outlive the batch they arrived with
+	if(type == TRANSACTION_DAO || type == TRANSACTION_DAS || event == TX_DELAYED_REQUEST || event == TX_FUTURE_AUTHORIZE) transaction->Detach();
+
 	return transaction;
 }
 
@@ -185,39 +185,49 @@ bool Processing::CheckBalance(ModulesInterface *interface, std::string from, uin
 	return true;
 }
 
+bool Processing::CheckSignatures(std::vector<SignatureStruct> &signatures, int &errorCode) {
+	if(Crypto::VerifyBatch(signatures)) return true;
+
+	//Report the first invalid one, following the order: sender, outbound, inbound
+	if(!signatures[0].valid) errorCode = ERROR_SIGNATURE_SENDER;
+	else if(!signatures[1].valid) errorCode = ERROR_SIGNATURE_OUTBOUND;
+	else errorCode = ERROR_SIGNATURE_INBOUND;
+	return false;
+}
+
 Entry* Processing::CreateEntry(std::string &content, int &errorCode) {
-	//Create generic NMEntry
-	Entry *entry = new Entry(content.c_str());
+	Entry *entry;
 	errorCode = VALID;
 
-	//check if it has the generic format
-	if(!entry->IsEntry()) {
+	//Parse it once
+	rapidjson::Document document;
+	document.Parse(content.c_str());
+
+	//check if it has the generic format, the specific one is verified below
+	if(!document.IsObject() || !document.HasMember("resource") || !document["resource"].IsString()) {
 		errorCode = ERROR_ENTRY_INVALID;
-		delete entry;
 		return NULL;
 	}
 
 	//retrieve resource type
-	std::string resource = entry->GetResource();
-	delete entry;
-
-	//Create specific NMEntry
-	if(resource == NMB_RESOURCE) entry = new ResourceEntry(content.c_str());
-	else if(resource == NMB_RESOURCE_PASSPORT) entry = new PassportEntry(content.c_str());
-	else if(resource == NMB_RESOURCE_ENTITY) entry = new EntityEntry(content.c_str());
-	else if(resource == NMB_RESOURCE_NODE) entry = new NodeEntry(content.c_str());
-	else if(resource == NMB_RESOURCE_DAO) entry = new DAOEntry(content.c_str());
-	else if(resource == NMB_RESOURCE_DAS) entry = new DASEntry(content.c_str());
-	else if(resource == NMB_RESOURCE_SLOT) entry = new SlotEntry(content.c_str());
-	else if(resource == NMB_RESOURCE_ACCOUNT) entry = new AccountEntry(content.c_str());
+	std::string resource = document["resource"].GetString();
+
+	//Create specific NMEntry, handing it the parsed document
+	if(resource == NMB_RESOURCE) entry = new ResourceEntry(document);
+	else if(resource == NMB_RESOURCE_PASSPORT) entry = new PassportEntry(document);
+	else if(resource == NMB_RESOURCE_ENTITY) entry = new EntityEntry(document);
+	else if(resource == NMB_RESOURCE_NODE) entry = new NodeEntry(document);
+	else if(resource == NMB_RESOURCE_DAO) entry = new DAOEntry(document);
+	else if(resource == NMB_RESOURCE_DAS) entry = new DASEntry(document);
+	else if(resource == NMB_RESOURCE_SLOT) entry = new SlotEntry(document);
+	else if(resource == NMB_RESOURCE_ACCOUNT) entry = new AccountEntry(document);
 	else {
 		errorCode = ERROR_RESOURCE;
-		delete entry;
 		return NULL;
 	}
 
-	//verify it follows the specific format
-	if(!entry->IsEntry()) {
+	//verify it follows the generic format, then the specific one
+	if(!entry->Entry::IsEntry() || !entry->IsEntry()) {
 		errorCode = ERROR_ENTRY_INVALID;
 		delete entry;
 		return NULL;
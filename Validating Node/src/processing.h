@@ -40,6 +40,7 @@
 
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "includes/boost/regex.hpp"
 
@@ -104,35 +105,43 @@ namespace Processing{
 	
 	bool CheckBalance(ModulesInterface *interface, std::string from, uint64_t amount, int &errorCode);
 	
+	bool CheckSignatures(std::vector<SignatureStruct> &signatures, int &errorCode);
+
 	template <typename T>
 	bool CheckSignatures(ModulesInterface *interface, T *Tx, int &errorCode) {
-		std::stringstream ss;
-		std::string message, publicKey;
+		//signatures are read in place from the transaction
+		std::vector<SignatureStruct> signatures(3);
 
-		//Verify sender's signature
-		if(!interface->GetPublicKey(Tx->GetSender(), publicKey) || !Crypto::Verify(Tx->GetCore(), Tx->GetSignature(), publicKey)) {
+		//Sender's signature
+		signatures[0].message = Tx->GetCore();
+		signatures[0].signature = Tx->GetSignature();
+		if(!interface->GetPublicKey(Tx->GetSender(), signatures[0])) {
 			errorCode = ERROR_SIGNATURE_SENDER;
 			return false;
 		}
 
-		//Verify Outbound signature
-		ss << Tx->GetSignature() << Tx->GetOutboundAccount() << Tx->GetOutboundFee();
-		message = ss.str();
-		if(!interface->GetManagingEntityKey(Tx->GetOutboundAccount(), publicKey) || !Crypto::Verify(message, Tx->GetOutboundSignature(), publicKey)) {
+		//Outbound signature
+		signatures[1].message.assign(signatures[0].signature.data, signatures[0].signature.length);
+		signatures[1].message.append(Tx->GetOutboundAccount());
+		signatures[1].message.append(std::to_string(Tx->GetOutboundFee()));
+		signatures[1].signature = Tx->GetOutboundSignature();
+		if(!interface->GetManagingEntityKey(Tx->GetOutboundAccount(), signatures[1])) {
 			errorCode = ERROR_SIGNATURE_OUTBOUND;
 			return false;
 		}
 
-		//Verify Inbound signature
-		ss.str("");
-		ss << Tx->GetOutboundSignature() << Tx->GetInboundAccount() << Tx->GetInboundFee();
-		message = ss.str();
-		if(!interface->GetManagingEntityKey(Tx->GetInboundAccount(), publicKey) || !Crypto::Verify(message, Tx->GetInboundSignature(), publicKey)) {
+		//Inbound signature
+		signatures[2].message.assign(signatures[1].signature.data, signatures[1].signature.length);
+		signatures[2].message.append(Tx->GetInboundAccount());
+		signatures[2].message.append(std::to_string(Tx->GetInboundFee()));
+		signatures[2].signature = Tx->GetInboundSignature();
+		if(!interface->GetManagingEntityKey(Tx->GetInboundAccount(), signatures[2])) {
 			errorCode = ERROR_SIGNATURE_INBOUND;
 			return false;
 		}
 
-		return true;
+		//Verify all of them at once
+		return CheckSignatures(signatures, errorCode);
 	}
 
 	Entry* CreateEntry(std::string &content, int &errorCode);
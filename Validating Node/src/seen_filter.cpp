@@ -0,0 +1,106 @@
+/*
+	Copyright (c) 2016-2017, Unified Digital Currency
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+	WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/**
+ * @file seen_filter.cpp
+ * @author Rafael Afonso Rodrigues <founder@udc.world>
+ * @date 2016
+ * UDC Validating Node.
+ */
+
+#include <atomic>
+#include <cstring>
+#include <initializer_list>
+#include <vector>
+
+#include "globals.h"
+#include "hash160.h"
+#include "seen_filter.h"
+#include "util.h"
+
+
+SeenFilter::SeenFilter() : generation(Util::current_timestamp_nanos() / SEEN_FILTER_INTERVAL) {
+	for(uint i = 0; i < SEEN_FILTER_GENERATIONS; i++) {
+		bits[i] = std::vector<std::atomic<uint64_t>>(SEEN_FILTER_BITS / 64);
+		for(auto &word: bits[i]) word.store(0, std::memory_order_relaxed);
+	}
+}
+
+void SeenFilter::Insert(const Hash160 &hash) {
+	uint64_t probes[SEEN_FILTER_HASHES];
+	Probes(hash, probes);
+
+	std::vector<std::atomic<uint64_t>> &current = bits[Rotate() % SEEN_FILTER_GENERATIONS];
+	for(uint i = 0; i < SEEN_FILTER_HASHES; i++) {
+		current[probes[i] / 64].fetch_or((uint64_t)1 << (probes[i] % 64), std::memory_order_relaxed);
+	}
+}
+
+bool SeenFilter::MayContain(const Hash160 &hash) {
+	uint64_t probes[SEEN_FILTER_HASHES];
+	Probes(hash, probes);
+
+	//Check the current and the previous generations
+	uint64_t now = Rotate();
+	for(uint64_t g: {now, now - 1}) {
+		std::vector<std::atomic<uint64_t>> &filter = bits[g % SEEN_FILTER_GENERATIONS];
+
+		uint i = 0;
+		while(i < SEEN_FILTER_HASHES && (filter[probes[i] / 64].load(std::memory_order_relaxed) >> (probes[i] % 64)) & 1) i++;
+		if(i == SEEN_FILTER_HASHES) return true;
+	}
+	return false;
+}
+
+uint64_t SeenFilter::Rotate() {
+	uint64_t current = generation.load(std::memory_order_acquire);
+	uint64_t now = Util::current_timestamp_nanos() / SEEN_FILTER_INTERVAL;
+	if(now <= current) return current;
+
+	//Only the thread moving the generation forward clears the expired ones
+	if(generation.compare_exchange_strong(current, now, std::memory_order_acq_rel)) {
+		for(uint64_t g = now; g > current && g + SEEN_FILTER_GENERATIONS > now; g--) {
+			for(auto &word: bits[g % SEEN_FILTER_GENERATIONS]) word.store(0, std::memory_order_relaxed);
+		}
+		return now;
+	}
+	//Another thread did it meanwhile
+	return current;
+}
+
+void SeenFilter::Probes(const Hash160 &hash, uint64_t probes[]) {
+	//Hashes are already uniform, split them into two independent halves for double hashing
+	uint64_t h1, h2;
+	std::memcpy(&h1, hash.bytes, sizeof(h1));
+	std::memcpy(&h2, hash.bytes + sizeof(h1), sizeof(h2));
+	h2 |= 1;
+
+	for(uint i = 0; i < SEEN_FILTER_HASHES; i++) probes[i] = (h1 + i * h2) % SEEN_FILTER_BITS;
+}
\ No newline at end of file
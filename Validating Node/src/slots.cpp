@@ -46,7 +46,7 @@
 #include "slots.h"
 
 
-Slots::Slots(rocksdb::DB* slotsDB) : db(slotsDB) {
+Slots::Slots(rocksdb::DB* slotsDB, rocksdb::ColumnFamilyHandle *family) : db(slotsDB), family(family) {
 	backupFile.open(LOCAL_DATA_SLOTS, std::fstream::out | std::fstream::app);
 }
 
@@ -55,7 +55,7 @@ bool Slots::BackupData() {
 	backupFile.close();
 	backupFile.open(LOCAL_DATA_SLOTS, std::fstream::out | std::fstream::trunc);
 
-	auto iter = db->NewIterator(rocksdb::ReadOptions());
+	auto iter = db->NewIterator(rocksdb::ReadOptions(), family);
 	iter->SeekToFirst();
 
 	while(iter->Valid()) {
@@ -81,7 +81,7 @@ bool Slots::GetEntity(std::string account, std::string &entity, bool fromAccount
 
 	std::lock_guard<std::mutex> lock(dbMutex);
 	//Fetch Managing Entity's ID
-	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), slot, &entity);
+	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), family, slot, &entity);
 	return !status.IsNotFound();
 }
 
@@ -93,7 +93,7 @@ bool Slots::SetEntity(std::string slot, std::string entity) {
 	if(!boost::regex_match(slot, slotRegex) || !boost::regex_match(entity, idRegex)) return false;
 
 	//Upsert the Slot's Managing Entity
-	rocksdb::Status status = db->Put(rocksdb::WriteOptions(), slot, entity);
+	rocksdb::Status status = db->Put(rocksdb::WriteOptions(), family, slot, entity);
 	if(status.ok()) {
 		BackupData(slot, entity);
 		return true;
@@ -103,7 +103,7 @@ bool Slots::SetEntity(std::string slot, std::string entity) {
 
 bool Slots::IsActivated(std::string slot) {
 	std::string value;
-	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), slot, &value);
+	rocksdb::Status status = db->Get(rocksdb::ReadOptions(), family, slot, &value);
 	return !status.IsNotFound();
 }
 
@@ -111,7 +111,7 @@ bool Slots::RemoveSlot(std::string slot) {
 	boost::regex slotRegex(PATTERN_SLOT);
 
 	if(boost::regex_match(slot, slotRegex)) {
-		rocksdb::Status status = db->Delete(rocksdb::WriteOptions(), slot);
+		rocksdb::Status status = db->Delete(rocksdb::WriteOptions(), family, slot);
 		return status.ok();
 	}
 	return false;
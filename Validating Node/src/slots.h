@@ -47,7 +47,7 @@
 
 class Slots {
 	public:
-		Slots(rocksdb::DB* slotsDB);
+		Slots(rocksdb::DB* slotsDB, rocksdb::ColumnFamilyHandle *family);
 		~Slots(){}
 		bool BackupData();
 
@@ -60,6 +60,7 @@ class Slots {
 	private:
 		std::mutex dbMutex;
 		rocksdb::DB* db;
+		rocksdb::ColumnFamilyHandle *family;
 		std::fstream backupFile;
 		
 		void BackupData(std::string slot, std::string entity);
@@ -0,0 +1,167 @@
+/*
+	Copyright (c) 2016-2017, Unified Digital Currency
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+	WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/**
+ * @file stats.cpp
+ * @author Rafael Afonso Rodrigues <founder@udc.world>
+ * @date 2016
+ * UDC Validating Node.
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <string>
+
+#include "includes/boost/asio.hpp"
+
+#include "globals.h"
+#include "stats.h"
+#include "transaction.h"
+#include "util.h"
+
+
+static LatencyHistogram histograms[TRANSACTION_STAGES];
+static const char *stageNames[TRANSACTION_STAGES] = {"total", "parse", "verify", "execute", "broadcast", "confirm", "publish", "register"};
+
+//Counts at the previous dump, for throughputs
+static std::mutex dumpMutex;
+static uint64_t lastCounts[TRANSACTION_STAGES] = {};
+static uint64_t lastDump = 0;
+
+
+LatencyHistogram::LatencyHistogram() : count(0), max(0) {
+	for(uint i = 0; i < STATS_BUCKETS; i++) buckets[i].store(0, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::Record(uint64_t nanos) {
+	buckets[Bucket(nanos)].fetch_add(1, std::memory_order_relaxed);
+	count.fetch_add(1, std::memory_order_relaxed);
+
+	uint64_t current = max.load(std::memory_order_relaxed);
+	while(nanos > current && !max.compare_exchange_weak(current, nanos, std::memory_order_relaxed));
+}
+
+uint64_t LatencyHistogram::Count() {
+	return count.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::Percentile(double percentile) {
+	uint64_t total = 0;
+	uint64_t counts[STATS_BUCKETS];
+	for(uint i = 0; i < STATS_BUCKETS; i++) total += (counts[i] = buckets[i].load(std::memory_order_relaxed));
+	if(!total) return 0;
+
+	uint64_t rank = total * percentile / 100, seen = 0;
+	for(uint i = 0; i < STATS_BUCKETS; i++) {
+		seen += counts[i];
+		if(seen > rank) return Value(i);
+	}
+	return Max();
+}
+
+uint64_t LatencyHistogram::Max() {
+	return max.load(std::memory_order_relaxed);
+}
+
+uint LatencyHistogram::Bucket(uint64_t nanos) {
+	if(nanos < STATS_SUB_BUCKETS) return nanos;
+
+	//Power of two, then the next 4 bits below it
+	uint exponent = 63 - __builtin_clzll(nanos);
+	return (exponent - 3) * STATS_SUB_BUCKETS + ((nanos >> (exponent - 4)) & (STATS_SUB_BUCKETS - 1));
+}
+
+uint64_t LatencyHistogram::Value(uint bucket) {
+	if(bucket < STATS_SUB_BUCKETS) return bucket;
+
+	//middle of the bucket's range
+	uint exponent = bucket / STATS_SUB_BUCKETS + 3;
+	uint64_t lower = (uint64_t)(STATS_SUB_BUCKETS + bucket % STATS_SUB_BUCKETS) << (exponent - 4);
+	return lower + ((uint64_t)1 << (exponent - 4)) / 2;
+}
+
+void Stats::Record(uint stage, uint64_t nanos) {
+	if(stage < TRANSACTION_STAGES) histograms[stage].Record(nanos);
+}
+
+std::string Stats::Dump() {
+	std::lock_guard<std::mutex> lock(dumpMutex);
+	uint64_t now = Util::current_timestamp_nanos();
+	double elapsed = lastDump ? (now - lastDump) / 1000000000.0 : 0;
+	lastDump = now;
+
+	char line[160];
+	std::string output = "stage        count        tx/s      p50(us)    p99(us)   p999(us)    max(us)\n";
+
+	for(uint i = 0; i < TRANSACTION_STAGES; i++) {
+		//a stage's histogram only holds the time spent since the previous one
+		uint stage = (i + 1) % TRANSACTION_STAGES;
+		LatencyHistogram &histogram = histograms[stage];
+
+		uint64_t count = histogram.Count();
+		double rate = elapsed > 0 ? (count - lastCounts[stage]) / elapsed : 0;
+		lastCounts[stage] = count;
+
+		snprintf(line, sizeof(line), "%-10s %7llu %11.1f %12.1f %10.1f %10.1f %10.1f\n", stageNames[stage], (unsigned long long)count, rate,
+			histogram.Percentile(50) / 1000.0, histogram.Percentile(99) / 1000.0, histogram.Percentile(99.9) / 1000.0, histogram.Max() / 1000.0);
+		output += line;
+	}
+
+	output += "serializations: " + std::to_string(Transaction::Serializations()) + "\n";
+	return output;
+}
+
+void Stats::Serve(bool *IS_OPERATING) {
+	//Loopback only, anyone connecting gets the statistics and is disconnected
+	boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address_v4::loopback(), STATS_PORT);
+	boost::asio::ip::tcp::acceptor acceptor(NETWORK_SOCKET_SERVICE);
+	boost::system::error_code error;
+
+	//The node runs just as well without it, e.g. when the port is taken
+	acceptor.open(endpoint.protocol(), error);
+	if(!error) acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true), error);
+	if(!error) acceptor.bind(endpoint, error);
+	if(!error) acceptor.listen(boost::asio::socket_base::max_connections, error);
+	if(error) {
+		std::cout << "\nWARNING: statistics are not served on port " << STATS_PORT << ": " << error.message() << std::endl;
+		return;
+	}
+
+	while(*IS_OPERATING) {
+		boost::asio::ip::tcp::socket socket(NETWORK_SOCKET_SERVICE);
+		acceptor.accept(socket, error);
+		if(error) continue;
+
+		boost::asio::write(socket, boost::asio::buffer(Dump()), boost::asio::transfer_all(), error);
+		socket.close();
+	}
+}
\ No newline at end of file
@@ -56,6 +56,7 @@
 #include "node.h"
 #include "publisher.h"
 #include "slots.h"
+#include "stats.h"
 #include "threads_manager.h"
 #include "transactions_manager.h"
 #include "util.h"
@@ -117,9 +118,8 @@ void StartFeeRedistribution(bool *IS_OPERATING, bool *IS_SYNCHRONIZED, DAOManage
 	}
 }
 
-void StartDataBackup(bool *IS_OPERATING, Keys *keysDB, NetworkManager *networkManager, Publisher *publisher, Slots *slotsDB) {
+void StartDataBackup(bool *IS_OPERATING, NetworkManager *networkManager, Publisher *publisher, Slots *slotsDB) {
 	uint now = Util::current_timestamp();
-	uint nextKeysBackup = now + KEYS_BACKUP_INTERVAL;
 	uint nextNetworkBackup = now + NETWORK_BACKUP_INTERVAL;
 	uint nextPublisherBackup = now + PUBLISHER_BACKUP_INTERVAL;
 	uint nextSlotsBackup = now + SLOTS_BACKUP_INTERVAL;
@@ -127,13 +127,9 @@ void StartDataBackup(bool *IS_OPERATING, Keys *keysDB, NetworkManager *networkMa
 	while(*IS_OPERATING) {
 		now = Util::current_timestamp();
 
-		if(now >= nextKeysBackup) {
-			if(keysDB->BackupData()) nextKeysBackup += KEYS_BACKUP_INTERVAL;
-		}
-
+		//Public keys share its database, they're backed up along with it
 		if(now >= nextNetworkBackup) {
-			networkManager->BackupData();
-			nextNetworkBackup += NETWORK_BACKUP_INTERVAL;
+			if(networkManager->BackupData()) nextNetworkBackup += NETWORK_BACKUP_INTERVAL;
 		}
 
 		if(now >= nextPublisherBackup) {
@@ -155,6 +151,17 @@ void StartKeepAlive(bool *IS_OPERATING, Nodes *nodes) {
 		std::this_thread::sleep_for(std::chrono::seconds(NODE_KEEP_ALIVE_INTERVAL));
 	}
 }
+
+void StartConfirmationsFlush(bool *IS_OPERATING, Nodes *nodes) {
+	while(*IS_OPERATING) {
+		nodes->FlushConfirmations();
+		std::this_thread::sleep_for(std::chrono::milliseconds(NODE_CONFIRMATIONS_INTERVAL));
+	}
+}
+
+void StartStatsServer(bool *IS_OPERATING) {
+	Stats::Serve(IS_OPERATING);
+}
 ThreadsManager::ThreadsManager(Balances *balancesDB, DAOManager *managerDAO, DASManager *managerDAS, Entities *entities, Keys *keysDB, Ledger *ledger, ModulesInterface *interface, NetworkManager *networkManager, Nodes *nodes, Publisher *publisher, Slots *slotsDB, TransactionsManager *txManager)
 : balancesDB(balancesDB), managerDAO(managerDAO), managerDAS(managerDAS), entities(entities), keysDB(keysDB), ledger(ledger), interface(interface), networkManager(networkManager), nodes(nodes), publisher(publisher), slotsDB(slotsDB), txManager(txManager) {
 }
@@ -199,7 +206,15 @@ void ThreadsManager::LaunchThreads() {
 	keepAliveThread.detach();
 	std::cout << "\n - peers keep alive thread launched." << std::endl;
 
-	backupThread = std::thread(StartDataBackup, &IS_OPERATING, keysDB, networkManager, publisher, slotsDB);
+	confirmationsThread = std::thread(StartConfirmationsFlush, &IS_OPERATING, nodes);
+	confirmationsThread.detach();
+	std::cout << "\n - confirmations batching thread launched." << std::endl;
+
+	statsThread = std::thread(StartStatsServer, &IS_OPERATING);
+	statsThread.detach();
+	std::cout << "\n - statistics thread launched." << std::endl;
+
+	backupThread = std::thread(StartDataBackup, &IS_OPERATING, networkManager, publisher, slotsDB);
 	backupThread.detach();
 	std::cout << "\n - data backup thread launched." << std::endl;
 }
@@ -68,8 +68,10 @@ void StartNMBSupervision(bool *IS_OPERATING, NetworkManager *networkManager);
 void StartSlotSupervision(bool *IS_OPERATING, NetworkManager *networkManager);
 void StartLedgerSupervision(bool *IS_OPERATING, bool *IS_SYNCHRONIZED, TransactionsManager *txManager, Ledger *ledger);
 void StartFeeRedistribution(bool *IS_OPERATING, bool *IS_SYNCHRONIZED, DAOManager *managerDAO, DASManager *managerDAS);
-void StartDataBackup(bool *IS_OPERATING, Keys *keysDB, NetworkManager *networkManager, Publisher *publisher, Slots *slotsDB);
+void StartDataBackup(bool *IS_OPERATING, NetworkManager *networkManager, Publisher *publisher, Slots *slotsDB);
 void StartKeepAlive(bool *IS_OPERATING, Nodes *nodes);
+void StartConfirmationsFlush(bool *IS_OPERATING, Nodes *nodes);
+void StartStatsServer(bool *IS_OPERATING);
 
 class ThreadsManager {
 	public:
@@ -109,6 +111,8 @@ class ThreadsManager {
 
 		std::thread backupThread;
 		std::thread keepAliveThread;
+		std::thread confirmationsThread;
+		std::thread statsThread;
 		std::thread listeningThread;
 		
 		std::list<std::thread> nodeThreads;
@@ -0,0 +1,165 @@
+/*
+	Copyright (c) 2016-2017, Unified Digital Currency
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+	WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/**
+ * @file timer_wheel.cpp
+ * @author Rafael Afonso Rodrigues <founder@udc.world>
+ * @date 2016
+ * UDC Validating Node.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "globals.h"
+#include "hash160.h"
+#include "timer_wheel.h"
+#include "util.h"
+
+
+TimerWheel::TimerWheel(uint64_t resolution /*=TIMER_WHEEL_RESOLUTION*/) : resolution(resolution ? resolution : 1), size(0) {
+	for(uint level = 0; level < TIMER_WHEEL_LEVELS; level++) wheel[level].resize(TIMER_WHEEL_SLOTS);
+	currentTick = Util::current_timestamp_nanos() / this->resolution;
+}
+
+void TimerWheel::Schedule(Hash160 hash, uint type, uint64_t deadline) {
+	if(type >= TIMER_TYPES) return;
+	std::lock_guard<std::mutex> lock(timerMutex);
+
+	//Reschedule if already pending
+	auto it = timers[type].find(hash);
+	if(it != timers[type].end()) {
+		wheel[it->second->level][it->second->slot].erase(it->second);
+		size--;
+	}
+
+	Insert({hash, type, deadline, 0, 0});
+	size++;
+
+	//Wake up the registration thread if it was idle
+	if(size == 1) scheduleCondition.notify_one();
+}
+
+bool TimerWheel::Cancel(Hash160 hash, uint type) {
+	if(type >= TIMER_TYPES) return false;
+	std::lock_guard<std::mutex> lock(timerMutex);
+
+	auto it = timers[type].find(hash);
+	if(it == timers[type].end()) return false;
+
+	wheel[it->second->level][it->second->slot].erase(it->second);
+	timers[type].erase(it);
+	size--;
+	return true;
+}
+
+void TimerWheel::Advance(uint64_t now, std::vector<TimerStruct> &expired) {
+	std::lock_guard<std::mutex> lock(timerMutex);
+	uint64_t nowTick = now / resolution;
+
+	while(currentTick <= nowTick) {
+		//Nothing scheduled, skip the idle ticks
+		if(size == 0) {
+			currentTick = nowTick + 1;
+			break;
+		}
+
+		//Step 1: at the start of each period, move the higher levels' timers down
+		uint levels = 1;
+		while(levels < TIMER_WHEEL_LEVELS && !(currentTick & ((1ULL << (TIMER_WHEEL_BITS * levels)) - 1))) levels++;
+		for(uint level = levels - 1; level >= 1; level--) Cascade(level);
+
+		//Step 2: fire the timers of this tick
+		std::list<TimerStruct> &slot = wheel[0][currentTick & (TIMER_WHEEL_SLOTS - 1)];
+		for(auto it = slot.begin(); it != slot.end(); ++it) {
+			timers[it->type].erase(it->hash);
+			expired.push_back(std::move(*it));
+			size--;
+		}
+		slot.clear();
+
+		currentTick++;
+	}
+}
+
+void TimerWheel::Wait() {
+	std::unique_lock<std::mutex> lock(timerMutex);
+
+	//Park until something gets scheduled
+	if(size == 0) {
+		scheduleCondition.wait_for(lock, std::chrono::milliseconds(TIMER_WHEEL_IDLE_WAIT));
+		return;
+	}
+	lock.unlock();
+
+	//Otherwise sleep until the next tick
+	uint64_t now = Util::current_timestamp_nanos();
+	std::this_thread::sleep_for(std::chrono::nanoseconds(resolution - now % resolution));
+}
+
+size_t TimerWheel::Size() {
+	std::lock_guard<std::mutex> lock(timerMutex);
+	return size;
+}
+
+void TimerWheel::Insert(TimerStruct timer) {
+	uint64_t tick = timer.deadline / resolution;
+	if(tick < currentTick) tick = currentTick;
+	uint64_t delta = tick - currentTick;
+
+	//Deadlines beyond the last level wait at its end, and are cascaded again from there
+	if(delta >> (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) {
+		delta = (1ULL << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) - 1;
+		tick = currentTick + delta;
+	}
+
+	//Each level covers TIMER_WHEEL_BITS more bits of the remaining ticks
+	timer.level = 0;
+	while(timer.level < TIMER_WHEEL_LEVELS - 1 && (delta >> (TIMER_WHEEL_BITS * (timer.level + 1)))) timer.level++;
+	timer.slot = (tick >> (TIMER_WHEEL_BITS * timer.level)) & (TIMER_WHEEL_SLOTS - 1);
+
+	std::list<TimerStruct> &slot = wheel[timer.level][timer.slot];
+	slot.push_back(timer);
+	timers[timer.type][timer.hash] = std::prev(slot.end());
+}
+
+void TimerWheel::Cascade(uint level) {
+	std::list<TimerStruct> pending;
+	pending.swap(wheel[level][(currentTick >> (TIMER_WHEEL_BITS * level)) & (TIMER_WHEEL_SLOTS - 1)]);
+
+	for(auto it = pending.begin(); it != pending.end(); ++it) Insert(*it);
+}
\ No newline at end of file
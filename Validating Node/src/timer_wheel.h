@@ -0,0 +1,87 @@
+/*
+	Copyright (c) 2016-2017, Unified Digital Currency
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+	WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/**
+ * @file timer_wheel.h
+ * @author Rafael Afonso Rodrigues <founder@udc.world>
+ * @date 2016
+ * UDC Validating Node.
+ */
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "globals.h"
+#include "hash160.h"
+
+
+struct TimerStruct {
+	Hash160 hash;
+	uint type;
+	uint64_t deadline; //nanos
+	uint level;
+	uint slot;
+};
+
+//Hierarchical timer wheel, constant time scheduling and cancellation of transaction deadlines
+class TimerWheel {
+	public:
+		TimerWheel(uint64_t resolution=TIMER_WHEEL_RESOLUTION);
+		~TimerWheel(){}
+
+		void Schedule(Hash160 hash, uint type, uint64_t deadline);
+		bool Cancel(Hash160 hash, uint type);
+		void Advance(uint64_t now, std::vector<TimerStruct> &expired);
+		void Wait();
+
+		size_t Size();
+
+	private:
+		std::mutex timerMutex;
+		std::condition_variable scheduleCondition;
+
+		std::vector<std::list<TimerStruct>> wheel[TIMER_WHEEL_LEVELS];
+		std::unordered_map<Hash160, std::list<TimerStruct>::iterator> timers[TIMER_TYPES];
+		uint64_t resolution;
+		uint64_t currentTick; //next tick to be processed
+		size_t size;
+
+		void Insert(TimerStruct timer);
+		void Cascade(uint level);
+};
+
+#endif
\ No newline at end of file
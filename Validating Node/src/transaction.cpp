@@ -35,37 +35,58 @@
  * UDC Validating Node.
  */
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstring>
+#include <memory>
 #include <string>
 #include <utility>
 
 #include "includes/cryptopp/filters.h"
 #include "includes/cryptopp/ripemd.h"
-#include "includes/cryptopp/hex.h"
 #include "includes/rapidjson/stringbuffer.h"
 #include "includes/rapidjson/writer.h"
 
+#include "hash160.h"
 #include "modules_interface.h"
+#include "stats.h"
 #include "transaction.h"
+#include "transaction_arena.h"
 #include "util.h"
 
 
-Transaction::Transaction(const char *rawTx) {
+std::atomic<uint64_t> Transaction::serializations(0);
+
+Transaction::Transaction() : arena(TransactionArena::Current()), Tx(&arena->allocator) {}
+
+Transaction::Transaction(const char *rawTx) : arena(TransactionArena::Current()), Tx(&arena->allocator) {
 	Tx.Parse(rawTx);
 }
 
-Transaction::Transaction(const Transaction &Tx2) {
-	rapidjson::StringBuffer buffer;
-	rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-	Tx2.Tx.Accept(writer);
-	std::string temp = buffer.GetString();
-	Tx.Parse<0>(temp.c_str());
+Transaction::Transaction(rapidjson::Document &document, std::shared_ptr<TransactionArena> arena) : arena(arena), Tx(&arena->allocator) {
+	//take over an already parsed document, allocated from that same arena
+	std::swap(Tx, document);
+}
+
+Transaction::Transaction(const Transaction &Tx2) : arena(TransactionArena::Current()), Tx(&arena->allocator) {
+	//deep copy into this thread's arena, no need to serialize and parse again
+	Tx.CopyFrom(Tx2.Tx, Tx.GetAllocator());
+	canonical = Tx2.canonical;
+	digest = Tx2.digest;
 	hash = Tx2.hash;
+	data = Tx2.data;
+	for(uint i = 0; i < TRANSACTION_STAGES; i++) stages[i].store(Tx2.stages[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
 }
 
 Transaction& Transaction::operator=(Transaction& other) {
+	std::swap(arena, other.arena);
 	std::swap(Tx, other.Tx);
+	std::swap(canonical, other.canonical);
+	std::swap(digest, other.digest);
 	std::swap(hash, other.hash);
+	std::swap(data, other.data);
+	for(uint i = 0; i < TRANSACTION_STAGES; i++) stages[i].store(other.stages[i].exchange(stages[i].load(std::memory_order_relaxed), std::memory_order_relaxed), std::memory_order_relaxed);
 	return *this;
 }
 
@@ -75,10 +96,23 @@ bool Transaction::IsTransaction() {
 }
 
 void Transaction::OrderData() {
-	rapidjson::Document temp;
+	//same arena, the unordered copy is released along with it
+	rapidjson::Document temp(&arena->allocator);
 	temp.SetObject();
 	for(auto it = dataOrder.begin(); it != dataOrder.end(); ++it) Util::GenericCopier(Tx, temp, it, &temp.GetAllocator());
 	std::swap(Tx, temp);
+	canonical.clear();
+}
+
+void Transaction::Detach() {
+	//Transactions kept around for long get an arena of their own, sized after their document,
+	//instead of pinning the whole shared one; only called before anything else can reach them
+	std::shared_ptr<TransactionArena> shared = arena; //until the old document is gone
+	arena = std::make_shared<TransactionArena>(std::max<size_t>(canonical.size() * 2, TRANSACTION_ARENA_MIN_CHUNK));
+
+	rapidjson::Document copy(&arena->allocator);
+	copy.CopyFrom(Tx, copy.GetAllocator());
+	std::swap(Tx, copy);
 }
 
 bool Transaction::CheckTimestamp() {
@@ -86,26 +120,35 @@ bool Transaction::CheckTimestamp() {
 }
 
 std::string Transaction::MakeHash() {
-	CryptoPP::RIPEMD160 ripemd;
-	CryptoPP::StringSource ss(GetTransaction(), true, new CryptoPP::HashFilter(ripemd, new CryptoPP::HexEncoder(new CryptoPP::StringSink(hash))));
+	//canonical bytes are produced here, once, and reused by every later relay, append or publish
+	Serialize();
+	digest = Digest(canonical);
+	hash = digest.ToHex();
 	return hash;
 }
 
+bool Transaction::Verify(ModulesInterface *interface, int &errorCode) {
+	return true;
+}
+
 bool Transaction::Process(ModulesInterface *interface, int &errorCode) {
 	return false;
 }
 
-std::string Transaction::GetTransaction() {
-	rapidjson::StringBuffer buffer;
-	rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-	Tx.Accept(writer);
-	return buffer.GetString();
+const std::string& Transaction::GetTransaction() {
+	//only reached without a cached form if the transaction was never hashed
+	if(canonical.empty()) Serialize();
+	return canonical;
 }
 
 std::string Transaction::GetHash() {
 	return hash;
 }
 
+Hash160 Transaction::GetDigest() {
+	return digest;
+}
+
 std::string Transaction::GetType() {
 	return Tx["type"].GetString();
 }
@@ -116,4 +159,66 @@ uint64_t Transaction::GetTimestamp() {
 
 uint64_t Transaction::GetFees() {
 	return 0;
+}
+
+void Transaction::Stamp(uint stage, uint64_t now /*=0*/) {
+	if(!now) now = Util::current_timestamp_nanos();
+
+	if(stage != STAGE_RECEIVED) {
+		//Only transactions followed since their reception are measured, each stage once
+		uint64_t received = stages[STAGE_RECEIVED].load(std::memory_order_relaxed);
+		if(!received || stages[stage].load(std::memory_order_relaxed)) return;
+
+		//time spent since the latest stage reached
+		uint64_t latest = received;
+		for(uint i = 1; i < TRANSACTION_STAGES; i++) latest = std::max(latest, stages[i].load(std::memory_order_relaxed));
+		Stats::Record(stage, now > latest ? now - latest : 0);
+
+		if(stage == STAGE_REGISTERED) Stats::Record(STAGE_RECEIVED, now - received);
+	}
+	stages[stage].store(now, std::memory_order_relaxed);
+}
+
+bool Transaction::IsMeasured() {
+	return stages[STAGE_RECEIVED].load(std::memory_order_relaxed) != 0;
+}
+
+uint64_t Transaction::Serializations() {
+	return serializations.load(std::memory_order_relaxed);
+}
+
+Hash160 Transaction::Digest(const std::string &canonical) {
+	CryptoPP::RIPEMD160 ripemd;
+	std::string raw;
+	CryptoPP::StringSource ss(canonical, true, new CryptoPP::HashFilter(ripemd, new CryptoPP::StringSink(raw)));
+	return Hash160::FromDigest(raw);
+}
+
+void Transaction::Serialize() {
+	rapidjson::StringBuffer buffer;
+	rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+	Tx.Accept(writer);
+	canonical.assign(buffer.GetString(), buffer.GetSize());
+	serializations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Transaction::DecodeAccount(char account[], const rapidjson::Value &value) {
+	//anything not of account length is left blank, so Verify still rejects it as an invalid account
+	if(value.GetStringLength() == ACCOUNT_LENGTH) memcpy(account, value.GetString(), ACCOUNT_LENGTH);
+	else memset(account, 0, ACCOUNT_LENGTH);
+}
+
+void Transaction::DecodeField(unsigned int index, const rapidjson::Value &value) {
+	//only appended while the format is checked, views handed out later never move
+	data.fieldStart[index] = data.fields.size();
+	data.fieldLength[index] = value.GetStringLength();
+	data.fields.append(value.GetString(), value.GetStringLength());
+}
+
+std::string Transaction::ReadAccount(const char account[]) {
+	return std::string(account, ACCOUNT_LENGTH);
+}
+
+ByteViewStruct Transaction::ReadField(unsigned int index) {
+	return {data.fields.data() + data.fieldStart[index], data.fieldLength[index]};
 }
\ No newline at end of file
@@ -38,44 +38,94 @@
 #ifndef TRANSACTION_H
 #define TRANSACTION_H
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "includes/rapidjson/document.h"
 
+#include "byte_view.h"
+#include "globals.h"
+#include "hash160.h"
+
 class ModulesInterface;
+class TransactionArena;
+
+
+//Fixed layout of the fields used while processing, decoded once when the format is checked
+struct TransactionDataStruct {
+	uint64_t timestamp = 0;
+	uint64_t amount = 0;
+	uint64_t deadline = 0; //execution of a Request, validity of an Authorization
+	uint64_t outboundFee = 0;
+	uint64_t inboundFee = 0;
+	char sender[ACCOUNT_LENGTH] = {};
+	char receiver[ACCOUNT_LENGTH] = {};
+	char outboundAccount[ACCOUNT_LENGTH] = {};
+	char inboundAccount[ACCOUNT_LENGTH] = {};
+	std::string fields; //signatures and reference back to back, read in place through views
+	uint32_t fieldStart[TRANSACTION_FIELDS] = {};
+	uint32_t fieldLength[TRANSACTION_FIELDS] = {};
+};
 
 
 class Transaction {
 	public:
-		Transaction(){}
+		Transaction();
 		Transaction(const char rawTx[]);
+		Transaction(rapidjson::Document &document, std::shared_ptr<TransactionArena> arena);
 		Transaction(const Transaction &Tx2);
 		Transaction& operator=(Transaction& other);
 		virtual ~Transaction(){}
 
 		virtual bool IsTransaction();
 		virtual void OrderData();
+		void Detach();
 
 		virtual bool CheckTimestamp();
 		std::string MakeHash();
 
+		virtual bool Verify(ModulesInterface *interface, int &errorCode);
 		virtual bool Process(ModulesInterface *interface, int &errorCode);
 		virtual void Execute(std::vector<std::pair<std::string, uint64_t>> &from, std::vector<std::pair<std::string, uint64_t>> &to){}
 
-		std::string GetTransaction();
+		const std::string& GetTransaction();
 		std::string GetHash();
+		Hash160 GetDigest();
 		std::string GetType();
 		virtual uint64_t GetTimestamp();
 		virtual uint64_t GetFees();
+		virtual std::string GetSender(){ return ""; }
+
+		void Stamp(uint stage, uint64_t now=0);
+		bool IsMeasured();
+
+		static uint64_t Serializations();
+		static Hash160 Digest(const std::string &canonical);
 
 	protected:
+		void DecodeAccount(char account[], const rapidjson::Value &value);
+		void DecodeField(unsigned int index, const rapidjson::Value &value);
+		std::string ReadAccount(const char account[]);
+		ByteViewStruct ReadField(unsigned int index);
+
+		std::shared_ptr<TransactionArena> arena; //must outlive Tx
 		rapidjson::Document Tx;
+		std::string canonical; //serialized once the data is ordered
+		Hash160 digest; //binary form of hash
 		std::string hash;
+		TransactionDataStruct data;
 		
 		std::vector<std::string> dataOrder;
+		std::atomic<uint64_t> stages[TRANSACTION_STAGES] = {}; //lifecycle timestamps, stamped by different threads
+
+	private:
+		void Serialize();
+
+		static std::atomic<uint64_t> serializations;
 };
 
 
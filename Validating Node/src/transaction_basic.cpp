@@ -36,7 +36,6 @@
  */
 
 #include <chrono>
-#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -82,6 +81,19 @@ bool BasicTransaction::IsTransaction() {
 				dataOrder.push_back("account");
 				dataOrder.push_back("fee");
 				dataOrder.push_back("sig");
+
+				//Decode once, getters read from the fixed layout from now on
+				data.timestamp = Tx["timestamp"].GetUint64();
+				data.amount = Tx["amount"].GetUint64();
+				data.outboundFee = Tx["ob"]["fee"].GetUint64();
+				data.inboundFee = Tx["ib"]["fee"].GetUint64();
+				DecodeAccount(data.sender, Tx["sender"]);
+				DecodeAccount(data.receiver, Tx["receiver"]);
+				DecodeAccount(data.outboundAccount, Tx["ob"]["account"]);
+				DecodeAccount(data.inboundAccount, Tx["ib"]["account"]);
+				DecodeField(SIGNATURE_SENDER, Tx["sig"]);
+				DecodeField(SIGNATURE_OUTBOUND, Tx["ob"]["sig"]);
+				DecodeField(SIGNATURE_INBOUND, Tx["ib"]["sig"]);
 				return true;
 			}
 		}
@@ -98,22 +110,26 @@ bool BasicTransaction::CheckTimestamp() {
 	return true;
 }
 
-bool BasicTransaction::Process(ModulesInterface *interface, int &errorCode) {
+bool BasicTransaction::Verify(ModulesInterface *interface, int &errorCode) {
 	//Step 1: check amounts are correct
 	if(!Processing::CheckAmounts(this, errorCode)) return false;
 
 	//Step 2: verify if accounts are valid
 	if(!Processing::CheckAccounts(this, errorCode)) return false;
 
-	//Step 3: check if sender has enough funds
-	if(!Processing::CheckBalance(interface, GetSender(), GetAmount(), errorCode)) return false;
-
-	//Step 4: verify signatures
+	//Step 3: verify signatures
 	if(!Processing::CheckSignatures(interface, this, errorCode)) return false;
 
 	return true;
 }
 
+bool BasicTransaction::Process(ModulesInterface *interface, int &errorCode) {
+	//check if sender has enough funds
+	if(!Processing::CheckBalance(interface, GetSender(), GetAmount(), errorCode)) return false;
+
+	return true;
+}
+
 void BasicTransaction::Execute(std::vector<std::pair<std::string, uint64_t>> &from, std::vector<std::pair<std::string, uint64_t>> &to) {
 	from.push_back(std::make_pair(GetSender(), GetAmount()));
 	to.push_back(std::make_pair(GetReceiver(), GetNetAmount()));
@@ -122,52 +138,57 @@ void BasicTransaction::Execute(std::vector<std::pair<std::string, uint64_t>> &fr
 }
 
 uint64_t BasicTransaction::GetTimestamp() {
-	return Tx["timestamp"].GetUint64();
+	return data.timestamp;
 }
 
 std::string BasicTransaction::GetSender() {
-	return Tx["sender"].GetString();
+	return ReadAccount(data.sender);
 }
 
 std::string BasicTransaction::GetReceiver() {
-	return Tx["receiver"].GetString();
+	return ReadAccount(data.receiver);
 }
 
 uint64_t BasicTransaction::GetAmount() {
-	return Tx["amount"].GetUint64();
+	return data.amount;
 }
 
-std::string BasicTransaction::GetSignature() {
-	return Tx["sig"].GetString();
+ByteViewStruct BasicTransaction::GetSignature() {
+	return ReadField(SIGNATURE_SENDER);
 }
 
 std::string BasicTransaction::GetCore() {
-	std::stringstream ss;
-	ss << GetType() << GetTimestamp() << GetSender() << GetReceiver() << GetAmount();
-	return ss.str();
+	std::string core = GetType();
+	core.reserve(core.size() + 2*ACCOUNT_LENGTH + 40);
+	core.append(std::to_string(data.timestamp));
+	core.append(data.sender, ACCOUNT_LENGTH);
+	core.append(data.receiver, ACCOUNT_LENGTH);
+	core.append(std::to_string(data.amount));
+	return core;
 }
 
 std::string BasicTransaction::GetOutboundAccount() {
-	return Tx["ob"]["account"].GetString();
+	return ReadAccount(data.outboundAccount);
 }
 
 uint64_t BasicTransaction::GetOutboundFee() {
-	return Tx["ob"]["fee"].GetUint64();
+	return data.outboundFee;
 }
 
-std::string BasicTransaction::GetOutboundSignature() {
-	return Tx["ob"]["sig"].GetString();
+ByteViewStruct BasicTransaction::GetOutboundSignature() {
+	return ReadField(SIGNATURE_OUTBOUND);
 }
 
 std::string BasicTransaction::GetInboundAccount() {
-	return Tx["ib"]["account"].GetString();
+	return ReadAccount(data.inboundAccount);
 }
 
 uint64_t BasicTransaction::GetInboundFee() {
-	return Tx["ib"]["fee"].GetUint64();
+	return data.inboundFee;
 }
-std::string BasicTransaction::GetInboundSignature() {
-	return Tx["ib"]["sig"].GetString();
+
+ByteViewStruct BasicTransaction::GetInboundSignature() {
+	return ReadField(SIGNATURE_INBOUND);
 }
 
 uint64_t BasicTransaction::GetFees() {
@@ -51,10 +51,12 @@ class ModulesInterface;
 class BasicTransaction : public Transaction {
 	public:
 		BasicTransaction(const char rawTx[]) : Transaction(rawTx){}
+		BasicTransaction(rapidjson::Document &document, std::shared_ptr<TransactionArena> arena) : Transaction(document, arena){}
 
 		bool IsTransaction();
 		bool CheckTimestamp();
 
+		bool Verify(ModulesInterface *interface, int &errorCode);
 		bool Process(ModulesInterface *interface, int &errorCode);
 		void Execute(std::vector<std::pair<std::string, uint64_t>> &from, std::vector<std::pair<std::string, uint64_t>> &to);
 
@@ -62,16 +64,16 @@ class BasicTransaction : public Transaction {
 		std::string GetSender();
 		std::string GetReceiver();
 		uint64_t GetAmount();
-		std::string GetSignature();
+		ByteViewStruct GetSignature();
 		std::string GetCore();
 
 		std::string GetOutboundAccount();
 		uint64_t GetOutboundFee();
-		std::string GetOutboundSignature();
+		ByteViewStruct GetOutboundSignature();
 
 		std::string GetInboundAccount();
 		uint64_t GetInboundFee();
-		std::string GetInboundSignature();
+		ByteViewStruct GetInboundSignature();
 
 		uint64_t GetFees();
 		uint64_t GetNetAmount();
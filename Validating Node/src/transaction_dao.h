@@ -51,6 +51,7 @@ class DAOTransaction : public Transaction {
 	public:
 		DAOTransaction(){}
 		DAOTransaction(const char rawTx[]) : Transaction(rawTx){}
+		DAOTransaction(rapidjson::Document &document, std::shared_ptr<TransactionArena> arena) : Transaction(document, arena){}
 
 		virtual bool IsTransaction();
 
@@ -69,6 +70,7 @@ class FeeRedistributionDAOTransaction : public DAOTransaction {
 	public:
 		FeeRedistributionDAOTransaction(uint64_t start, uint64_t end, uint64_t total, uint64_t reported, std::map<std::string, uint64_t> shares, std::unordered_map<std::string, std::string> accounts);
 		FeeRedistributionDAOTransaction(const char rawTx[]) : DAOTransaction(rawTx){}
+		FeeRedistributionDAOTransaction(rapidjson::Document &document, std::shared_ptr<TransactionArena> arena) : DAOTransaction(document, arena){}
 
 		bool IsTransaction();
 		bool CheckTimestamp();
@@ -51,6 +51,7 @@ class DASTransaction : public Transaction {
 	public:
 		DASTransaction(){}
 		DASTransaction(const char rawTx[]) : Transaction(rawTx){}
+		DASTransaction(rapidjson::Document &document, std::shared_ptr<TransactionArena> arena) : Transaction(document, arena){}
 
 		virtual bool IsTransaction();
 
@@ -68,6 +69,7 @@ class FeeRedistributionDASTransaction : public DASTransaction {
 	public:
 		FeeRedistributionDASTransaction(uint64_t start, uint64_t end, uint64_t total, uint64_t reported, std::map<std::string, uint64_t> shares, std::unordered_map<std::string, std::string> accounts);
 		FeeRedistributionDASTransaction(const char rawTx[]) : DASTransaction(rawTx){}
+		FeeRedistributionDASTransaction(rapidjson::Document &document, std::shared_ptr<TransactionArena> arena) : DASTransaction(document, arena){}
 
 		bool IsTransaction();
 		bool CheckTimestamp();
@@ -38,7 +38,6 @@
 #include <chrono>
 #include <string>
 #include <utility>
-#include <sstream>
 #include <vector>
 
 #include "includes/boost/regex.hpp"
@@ -73,19 +72,26 @@ std::string DelayedTransaction::GetEvent() {
 }
 
 uint64_t DelayedTransaction::GetTimestamp() {
-	return Tx["timestamp"].GetUint64();
+	return data.timestamp;
 }
 
 std::string DelayedTransaction::GetSender() {
-	return Tx["sender"].GetString();
+	return ReadAccount(data.sender);
 }
 
 std::string DelayedTransaction::GetReceiver() {
-	return Tx["receiver"].GetString();
+	return ReadAccount(data.receiver);
 }
 
 uint64_t DelayedTransaction::GetAmount() {
-	return Tx["amount"].GetUint64();
+	return data.amount;
+}
+
+void DelayedTransaction::DecodeCommon() {
+	data.timestamp = Tx["timestamp"].GetUint64();
+	data.amount = Tx["amount"].GetUint64();
+	DecodeAccount(data.sender, Tx["sender"]);
+	DecodeAccount(data.receiver, Tx["receiver"]);
 }
 
 
@@ -122,6 +128,17 @@ bool RequestDelayedTransaction::IsTransaction() {
 				dataOrder.push_back("account");
 				dataOrder.push_back("fee");
 				dataOrder.push_back("sig");
+
+				//Decode once, getters read from the fixed layout from now on
+				DecodeCommon();
+				data.deadline = Tx["execution"].GetUint64();
+				data.outboundFee = Tx["ob"]["fee"].GetUint64();
+				data.inboundFee = Tx["ib"]["fee"].GetUint64();
+				DecodeAccount(data.outboundAccount, Tx["ob"]["account"]);
+				DecodeAccount(data.inboundAccount, Tx["ib"]["account"]);
+				DecodeField(SIGNATURE_SENDER, Tx["sig"]);
+				DecodeField(SIGNATURE_OUTBOUND, Tx["ob"]["sig"]);
+				DecodeField(SIGNATURE_INBOUND, Tx["ib"]["sig"]);
 				return true;
 			}
 		}
@@ -137,22 +154,26 @@ bool RequestDelayedTransaction::CheckTimestamp() {
 	return false;
 }
 
-bool RequestDelayedTransaction::Process(ModulesInterface *interface, int &errorCode) {
+bool RequestDelayedTransaction::Verify(ModulesInterface *interface, int &errorCode) {
 	//Step 1: check amounts are correct
 	if(!Processing::CheckAmounts(this, errorCode)) return false;
 
 	//Step 2: verify if accounts are valid
 	if(!Processing::CheckAccounts(this, errorCode)) return false;
 
-	//Step 3: check if has enough funds for fees
-	if(!Processing::CheckBalance(interface, GetSender(), GetFees(), errorCode)) return false;
-
 	//Step 3: verify signatures
 	if(!Processing::CheckSignatures(interface, this, errorCode)) return false;
 
 	return true;
 }
 
+bool RequestDelayedTransaction::Process(ModulesInterface *interface, int &errorCode) {
+	//check if has enough funds for fees
+	if(!Processing::CheckBalance(interface, GetSender(), GetFees(), errorCode)) return false;
+
+	return true;
+}
+
 void RequestDelayedTransaction::Execute(std::vector<std::pair<std::string, uint64_t>> &from, std::vector<std::pair<std::string, uint64_t>> &to) {
 	from.push_back(std::make_pair(GetSender(), GetFees()));
 	to.push_back(std::make_pair(GetOutboundAccount(), GetOutboundFee()));
@@ -160,41 +181,47 @@ void RequestDelayedTransaction::Execute(std::vector<std::pair<std::string, uint6
 }
 
 uint64_t RequestDelayedTransaction::GetExecution() {
-	return Tx["execution"].GetUint64();
+	return data.deadline;
 }
 
-std::string RequestDelayedTransaction::GetSignature() {
-	return Tx["sig"].GetString();
+ByteViewStruct RequestDelayedTransaction::GetSignature() {
+	return ReadField(SIGNATURE_SENDER);
 }
 
 std::string RequestDelayedTransaction::GetCore() {
-	std::stringstream ss;
-	ss << GetType() << GetEvent() << GetTimestamp() << GetExecution() << GetSender() << GetReceiver() << GetAmount();
-	return ss.str();
+	std::string core = GetType();
+	core.append(GetEvent());
+	core.reserve(core.size() + 2*ACCOUNT_LENGTH + 60);
+	core.append(std::to_string(data.timestamp));
+	core.append(std::to_string(data.deadline));
+	core.append(data.sender, ACCOUNT_LENGTH);
+	core.append(data.receiver, ACCOUNT_LENGTH);
+	core.append(std::to_string(data.amount));
+	return core;
 }
 
 std::string RequestDelayedTransaction::GetOutboundAccount() {
-	return Tx["ob"]["account"].GetString();
+	return ReadAccount(data.outboundAccount);
 }
 
 uint64_t RequestDelayedTransaction::GetOutboundFee() {
-	return Tx["ob"]["fee"].GetUint64();
+	return data.outboundFee;
 }
 
-std::string RequestDelayedTransaction::GetOutboundSignature() {
-	return Tx["ob"]["sig"].GetString();
+ByteViewStruct RequestDelayedTransaction::GetOutboundSignature() {
+	return ReadField(SIGNATURE_OUTBOUND);
 }
 
 std::string RequestDelayedTransaction::GetInboundAccount() {
-	return Tx["ib"]["account"].GetString();
+	return ReadAccount(data.inboundAccount);
 }
 
 uint64_t RequestDelayedTransaction::GetInboundFee() {
-	return Tx["ib"]["fee"].GetUint64();
+	return data.inboundFee;
 }
 
-std::string RequestDelayedTransaction::GetInboundSignature() {
-	return Tx["ib"]["sig"].GetString();
+ByteViewStruct RequestDelayedTransaction::GetInboundSignature() {
+	return ReadField(SIGNATURE_INBOUND);
 }
 
 uint64_t RequestDelayedTransaction::GetFees() {
@@ -220,16 +247,21 @@ bool ReleaseDelayedTransaction::IsTransaction() {
 			dataOrder.push_back("sender");
 			dataOrder.push_back("receiver");
 			dataOrder.push_back("amount");
+
+			//Decode once, getters read from the fixed layout from now on
+			DecodeCommon();
+			DecodeField(FIELD_REFERENCE, Tx["request"]);
 			return true;
 		}
 	}
 	return false;
 }
 
-bool ReleaseDelayedTransaction::Process(ModulesInterface *interface, int &errorCode) {
+bool ReleaseDelayedTransaction::Verify(ModulesInterface *interface, int &errorCode) {
 	//Ensure request is a valid hash
 	boost::regex hashRegex(PATTERN_HASH);
-	if(!boost::regex_match(GetRequest(), hashRegex)) {
+	ByteViewStruct request = GetRequest();
+	if(!boost::regex_match(request.data, request.data + request.length, hashRegex)) {
 		errorCode = ERROR_HASH;
 		return false;
 	}
@@ -245,9 +277,13 @@ bool ReleaseDelayedTransaction::Process(ModulesInterface *interface, int &errorC
 		return false;
 	}
 
+	return true;
+}
+
+bool ReleaseDelayedTransaction::Process(ModulesInterface *interface, int &errorCode) {
 	//Verify if the Request exists and is still pending
 	RequestDelayedTransaction *request;
-	if (!interface->FindRequest(GetRequest(), request, errorCode)) return false;
+	if (!interface->FindRequest(GetRequest().ToString(), request, errorCode)) return false;
 
 	//Verify that the Release contents correspond to the Request
 	if(request->GetExecution() != GetTimestamp() || request->GetSender() != GetSender() || request->GetReceiver() != GetReceiver() || request->GetNetAmount() != GetAmount()) {
@@ -256,7 +292,7 @@ bool ReleaseDelayedTransaction::Process(ModulesInterface *interface, int &errorC
 	}
 
 	//Check if sender has sufficient funds
-	if(Processing::CheckBalance(interface, GetSender(), GetAmount(), errorCode)) return false;
+	if(!Processing::CheckBalance(interface, GetSender(), GetAmount(), errorCode)) return false;
 
 	return true;
 }
@@ -266,6 +302,6 @@ void ReleaseDelayedTransaction::Execute(std::vector<std::pair<std::string, uint6
 	to.push_back(std::make_pair(GetReceiver(), GetAmount()));
 }
 
-std::string ReleaseDelayedTransaction::GetRequest() {
-	return Tx["request"].GetString();
+ByteViewStruct ReleaseDelayedTransaction::GetRequest() {
+	return ReadField(FIELD_REFERENCE);
 }
\ No newline at end of file
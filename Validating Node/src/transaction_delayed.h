@@ -52,6 +52,7 @@ class DelayedTransaction : public Transaction
 {
 	public:
 		DelayedTransaction(const char rawTx[]) : Transaction(rawTx){}
+		DelayedTransaction(rapidjson::Document &document, std::shared_ptr<TransactionArena> arena) : Transaction(document, arena){}
 
 		virtual bool IsTransaction();
 		virtual bool CheckTimestamp();
@@ -61,30 +62,35 @@ class DelayedTransaction : public Transaction
 		std::string GetSender();
 		std::string GetReceiver();
 		uint64_t GetAmount();
+
+	protected:
+		void DecodeCommon();
 };
 
 class RequestDelayedTransaction : public DelayedTransaction
 {
 	public:
 		RequestDelayedTransaction(const char rawTx[]) : DelayedTransaction(rawTx){}
+		RequestDelayedTransaction(rapidjson::Document &document, std::shared_ptr<TransactionArena> arena) : DelayedTransaction(document, arena){}
 
 		bool IsTransaction();
 		bool CheckTimestamp();
 		
+		bool Verify(ModulesInterface *interface, int &errorCode);
 		bool Process(ModulesInterface *interface, int &errorCode);
 		void Execute(std::vector<std::pair<std::string, uint64_t>> &from, std::vector<std::pair<std::string, uint64_t>> &to);
 
 		uint64_t GetExecution();
-		std::string GetSignature();
+		ByteViewStruct GetSignature();
 		std::string GetCore();
 
 		std::string GetOutboundAccount();
 		uint64_t GetOutboundFee();
-		std::string GetOutboundSignature();
+		ByteViewStruct GetOutboundSignature();
 
 		std::string GetInboundAccount();
 		uint64_t GetInboundFee();
-		std::string GetInboundSignature();
+		ByteViewStruct GetInboundSignature();
 
 		uint64_t GetFees();
 		uint64_t GetNetAmount();
@@ -95,13 +101,15 @@ class ReleaseDelayedTransaction : public DelayedTransaction
 {
 	public:
 		ReleaseDelayedTransaction(const char rawTx[]) : DelayedTransaction(rawTx){}
+		ReleaseDelayedTransaction(rapidjson::Document &document, std::shared_ptr<TransactionArena> arena) : DelayedTransaction(document, arena){}
 
 		bool IsTransaction();
 		
+		bool Verify(ModulesInterface *interface, int &errorCode);
 		bool Process(ModulesInterface *interface, int &errorCode);
 		void Execute(std::vector<std::pair<std::string, uint64_t>> &from, std::vector<std::pair<std::string, uint64_t>> &to);
 
-		std::string GetRequest();
+		ByteViewStruct GetRequest();
 };
 
 
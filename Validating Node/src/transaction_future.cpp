@@ -38,7 +38,6 @@
 #include <chrono>
 #include <string>
 #include <utility>
-#include <sstream>
 #include <vector>
 
 #include "includes/boost/regex.hpp"
@@ -71,23 +70,30 @@ std::string FutureTransaction::GetEvent() {
 }
 
 uint64_t FutureTransaction::GetTimestamp() {
-	return Tx["timestamp"].GetUint64();
+	return data.timestamp;
 }
 
 std::string FutureTransaction::GetSender() {
-	return Tx["sender"].GetString();
+	return ReadAccount(data.sender);
 }
 
 std::string FutureTransaction::GetReceiver() {
-	return Tx["receiver"].GetString();
+	return ReadAccount(data.receiver);
 }
 
 uint64_t FutureTransaction::GetAmount() {
-	return Tx["amount"].GetUint64();
+	return data.amount;
 }
 
-std::string FutureTransaction::GetSignature() {
-	return Tx["sig"].GetString();
+ByteViewStruct FutureTransaction::GetSignature() {
+	return ReadField(SIGNATURE_SENDER);
+}
+
+void FutureTransaction::DecodeCommon() {
+	data.timestamp = Tx["timestamp"].GetUint64();
+	data.amount = Tx["amount"].GetUint64();
+	DecodeAccount(data.sender, Tx["sender"]);
+	DecodeField(SIGNATURE_SENDER, Tx["sig"]);
 }
 
 
@@ -121,6 +127,12 @@ bool AuthorizeFutureTransaction::IsTransaction() {
 			else dataOrder.push_back("slot");
 			dataOrder.push_back("amount");
 			dataOrder.push_back("sig");
+
+			//Decode once, getters read from the fixed layout from now on
+			DecodeCommon();
+			data.deadline = Tx["validity"].GetUint64();
+			if(receiverSet) DecodeAccount(data.receiver, Tx["receiver"]);
+			else DecodeField(FIELD_REFERENCE, Tx["slot"]);
 			return true;
 		}
 	}
@@ -136,7 +148,7 @@ bool AuthorizeFutureTransaction::CheckTimestamp() {
 }
 
 
-bool AuthorizeFutureTransaction::Process(ModulesInterface *interface, int &errorCode) {
+bool AuthorizeFutureTransaction::Verify(ModulesInterface *interface, int &errorCode) {
 	//Check that sender, and eventually the receiver, are valid accounts
 	boost::regex accRegex(PATTERN_ACCOUNT);
 	if(!boost::regex_match(GetSender(), accRegex)) {
@@ -150,14 +162,15 @@ bool AuthorizeFutureTransaction::Process(ModulesInterface *interface, int &error
 
 	//If a slot was specified, check that it is valid
 	boost::regex slotRegex(PATTERN_SLOT);
-	if(slotSet && !boost::regex_match(GetSlot(), slotRegex)) {
+	ByteViewStruct slot = GetSlot();
+	if(slotSet && !boost::regex_match(slot.data, slot.data + slot.length, slotRegex)) {
 		errorCode = ERROR_SLOT;
 		return false;
 	}
 
 	//Verify sender's signature
 	std::string publicKey;
-	if(!interface->GetPublicKey(GetSender(), publicKey) || !Crypto::Verify(GetCore(), GetSignature(), publicKey)) {
+	if(!interface->GetPublicKey(GetSender(), publicKey) || !Crypto::Verify(GetCore(), GetSignature().ToString(), publicKey)) {
 		errorCode = ERROR_SIGNATURE_SENDER;
 		return false;
 	}
@@ -165,21 +178,30 @@ bool AuthorizeFutureTransaction::Process(ModulesInterface *interface, int &error
 	return true;
 }
 
+bool AuthorizeFutureTransaction::Process(ModulesInterface *interface, int &errorCode) {
+	//nothing depends on the current state, all checks are done by Verify
+	return true;
+}
+
 uint64_t AuthorizeFutureTransaction::GetValidity() {
-	return Tx["validity"].GetUint64();
+	return data.deadline;
 }
 
-std::string AuthorizeFutureTransaction::GetSlot() {
-	return Tx["slot"].GetString();
+ByteViewStruct AuthorizeFutureTransaction::GetSlot() {
+	return ReadField(FIELD_REFERENCE);
 }
 
 std::string AuthorizeFutureTransaction::GetCore() {
-	std::stringstream ss;
-	ss << GetType() << GetEvent() << GetTimestamp() << GetValidity() << GetSender();
-	if(receiverSet) ss << GetReceiver();
-	else if (slotSet) ss << GetSlot();
-	ss << GetAmount();
-	return ss.str();
+	std::string core = GetType();
+	core.append(GetEvent());
+	core.reserve(core.size() + 2*ACCOUNT_LENGTH + 60);
+	core.append(std::to_string(data.timestamp));
+	core.append(std::to_string(data.deadline));
+	core.append(data.sender, ACCOUNT_LENGTH);
+	if(receiverSet) core.append(data.receiver, ACCOUNT_LENGTH);
+	else if (slotSet) core.append(data.fields, data.fieldStart[FIELD_REFERENCE], data.fieldLength[FIELD_REFERENCE]);
+	core.append(std::to_string(data.amount));
+	return core;
 }
 
 bool AuthorizeFutureTransaction::HasReceiver() {
@@ -224,6 +246,17 @@ bool ExecuteFutureTransaction::IsTransaction() {
 				dataOrder.push_back("account");
 				dataOrder.push_back("fee");
 				dataOrder.push_back("sig");
+
+				//Decode once, getters read from the fixed layout from now on
+				DecodeCommon();
+				DecodeField(FIELD_REFERENCE, Tx["future"]);
+				data.outboundFee = Tx["ob"]["fee"].GetUint64();
+				data.inboundFee = Tx["ib"]["fee"].GetUint64();
+				DecodeAccount(data.receiver, Tx["receiver"]);
+				DecodeAccount(data.outboundAccount, Tx["ob"]["account"]);
+				DecodeAccount(data.inboundAccount, Tx["ib"]["account"]);
+				DecodeField(SIGNATURE_OUTBOUND, Tx["ob"]["sig"]);
+				DecodeField(SIGNATURE_INBOUND, Tx["ib"]["sig"]);
 				return true;
 			}
 		}
@@ -231,7 +264,7 @@ bool ExecuteFutureTransaction::IsTransaction() {
 	return false;
 }
 
-bool ExecuteFutureTransaction::Process(ModulesInterface *interface, int &errorCode) {
+bool ExecuteFutureTransaction::Verify(ModulesInterface *interface, int &errorCode) {
 	//Step 1: check amounts are correct
 	if(!Processing::CheckAmounts(this, errorCode)) return false;
 
@@ -240,48 +273,59 @@ bool ExecuteFutureTransaction::Process(ModulesInterface *interface, int &errorCo
 
 	//Step 3: ensure future contains a hash
 	boost::regex hashRegex(PATTERN_HASH);
-	if(!boost::regex_match(GetFuture(), hashRegex)) {
+	ByteViewStruct future = GetFuture();
+	if(!boost::regex_match(future.data, future.data + future.length, hashRegex)) {
 		errorCode = ERROR_HASH;
 		return false;
 	}
 
-	//Step 4: verify signatures	
-	std::stringstream ss;
-	std::string message, publicKey;
+	//Step 4: verify signatures, read in place from the transaction
+	std::vector<SignatureStruct> signatures(3);
 
-	//Verify sender's signature
-	if(!interface->GetPublicKey(GetSender(), publicKey) || !Crypto::Verify(GetFuture(), GetSignature(), publicKey)) {
+	//Sender's signature
+	signatures[0].message = future.ToString();
+	signatures[0].signature = GetSignature();
+	if(!interface->GetPublicKey(GetSender(), signatures[0])) {
 		errorCode = ERROR_SIGNATURE_SENDER;
 		return false;
 	}
-	//Verify Outbound signature
-	ss << GetCore() << GetSignature() << GetOutboundAccount() << GetOutboundFee();
-	message = ss.str();
-	if(!interface->GetManagingEntityKey(GetOutboundAccount(), publicKey) || !Crypto::Verify(message, GetOutboundSignature(), publicKey)) {
+	//Outbound signature
+	signatures[1].message = GetCore();
+	signatures[1].message.append(signatures[0].signature.data, signatures[0].signature.length);
+	signatures[1].message.append(GetOutboundAccount());
+	signatures[1].message.append(std::to_string(GetOutboundFee()));
+	signatures[1].signature = GetOutboundSignature();
+	if(!interface->GetManagingEntityKey(GetOutboundAccount(), signatures[1])) {
 		errorCode = ERROR_SIGNATURE_OUTBOUND;
 		return false;
 	}
-	//Verify Inbound signature
-	ss.str();
-	ss << GetOutboundSignature() << GetInboundAccount() << GetInboundFee();
-	message = ss.str();
-	if(!interface->GetManagingEntityKey(GetInboundAccount(), publicKey) || !Crypto::Verify(message, GetInboundSignature(), publicKey)) {
+	//Inbound signature, its message follows on the outbound one's
+	signatures[2].message = signatures[1].message;
+	signatures[2].message.append(signatures[1].signature.data, signatures[1].signature.length);
+	signatures[2].message.append(GetInboundAccount());
+	signatures[2].message.append(std::to_string(GetInboundFee()));
+	signatures[2].signature = GetInboundSignature();
+	if(!interface->GetManagingEntityKey(GetInboundAccount(), signatures[2])) {
 		errorCode = ERROR_SIGNATURE_INBOUND;
 		return false;
 	}
 
-	//Step 5: check authorization	
+	return Processing::CheckSignatures(signatures, errorCode);
+}
+
+bool ExecuteFutureTransaction::Process(ModulesInterface *interface, int &errorCode) {
+	//Step 1: check authorization	
 	AuthorizeFutureTransaction *authorization;
-	if (!interface->FindAuthorize(GetFuture(), authorization, errorCode)) return false;
+	if (!interface->FindAuthorize(GetFuture().ToString(), authorization, errorCode)) return false;
 	//Ensure it is still valid
 	if (authorization->GetValidity() < GetTimestamp()) errorCode = ERROR_TIMESTAMP;
 	//Check that if a Slot was specified, the receiver corresponds to it
-	else if(authorization->HasSlot() && authorization->GetSlot() != GetReceiver().substr(0, SLOT_LENGTH)) errorCode = ERROR_SLOT;
+	else if(authorization->HasSlot() && GetReceiver().compare(0, SLOT_LENGTH, authorization->GetSlot().data, authorization->GetSlot().length)) errorCode = ERROR_SLOT;
 	//Ensure the remaining content matches the authorization
 	else if(authorization->GetSender() != GetSender() || (authorization->HasReceiver() && authorization->GetReceiver() != GetReceiver()) || authorization->GetAmount() < GetAmount()) errorCode = ERROR_CONTENT;
 	if(errorCode != VALID) return false;
 
-	//Step 6: verify if the sender has sufficient funds
+	//Step 2: verify if the sender has sufficient funds
 	if(!Processing::CheckBalance(interface, GetSender(), GetAmount(), errorCode)) return false;
 
 	return true;
@@ -294,38 +338,44 @@ void ExecuteFutureTransaction::Execute(std::vector<std::pair<std::string, uint64
 	to.push_back(std::make_pair(GetInboundAccount(), GetInboundFee()));
 }
 
-std::string ExecuteFutureTransaction::GetFuture() {
-	return Tx["future"].GetString();
+ByteViewStruct ExecuteFutureTransaction::GetFuture() {
+	return ReadField(FIELD_REFERENCE);
 }
 
 std::string ExecuteFutureTransaction::GetCore() {
-	std::stringstream ss;
-	ss << GetType() << GetEvent() << GetTimestamp() << GetSender() << GetReceiver() << GetAmount() << GetFuture();
-	return ss.str();
+	std::string core = GetType();
+	core.append(GetEvent());
+	core.reserve(core.size() + 2*ACCOUNT_LENGTH + data.fieldLength[FIELD_REFERENCE] + 40);
+	core.append(std::to_string(data.timestamp));
+	core.append(data.sender, ACCOUNT_LENGTH);
+	core.append(data.receiver, ACCOUNT_LENGTH);
+	core.append(std::to_string(data.amount));
+	core.append(data.fields, data.fieldStart[FIELD_REFERENCE], data.fieldLength[FIELD_REFERENCE]);
+	return core;
 }
 
 std::string ExecuteFutureTransaction::GetOutboundAccount() {
-	return Tx["ob"]["account"].GetString();
+	return ReadAccount(data.outboundAccount);
 }
 
 uint64_t ExecuteFutureTransaction::GetOutboundFee() {
-	return Tx["ob"]["fee"].GetUint64();
+	return data.outboundFee;
 }
 
-std::string ExecuteFutureTransaction::GetOutboundSignature() {
-	return Tx["ob"]["sig"].GetString();
+ByteViewStruct ExecuteFutureTransaction::GetOutboundSignature() {
+	return ReadField(SIGNATURE_OUTBOUND);
 }
 
 std::string ExecuteFutureTransaction::GetInboundAccount() {
-	return Tx["ib"]["account"].GetString();
+	return ReadAccount(data.inboundAccount);
 }
 
 uint64_t ExecuteFutureTransaction::GetInboundFee() {
-	return Tx["ib"]["fee"].GetUint64();
+	return data.inboundFee;
 }
 
-std::string ExecuteFutureTransaction::GetInboundSignature() {
-	return Tx["ib"]["sig"].GetString();
+ByteViewStruct ExecuteFutureTransaction::GetInboundSignature() {
+	return ReadField(SIGNATURE_INBOUND);
 }
 
 uint64_t ExecuteFutureTransaction::GetFees() {
@@ -52,6 +52,7 @@ class FutureTransaction : public Transaction
 {
 	public:
 		FutureTransaction(const char rawTx[]) : Transaction(rawTx){}
+		FutureTransaction(rapidjson::Document &document, std::shared_ptr<TransactionArena> arena) : Transaction(document, arena){}
 
 		virtual bool IsTransaction();
 		virtual bool CheckTimestamp();
@@ -61,23 +62,27 @@ class FutureTransaction : public Transaction
 		std::string GetSender();
 		std::string GetReceiver();
 		uint64_t GetAmount();
-		std::string GetSignature();
+		ByteViewStruct GetSignature();
 
+	protected:
+		void DecodeCommon();
 };
 
 class AuthorizeFutureTransaction : public FutureTransaction
 {
 	public:
 		AuthorizeFutureTransaction(const char rawTx[]) : FutureTransaction(rawTx){}
+		AuthorizeFutureTransaction(rapidjson::Document &document, std::shared_ptr<TransactionArena> arena) : FutureTransaction(document, arena){}
 
 		bool IsTransaction();
 		bool CheckTimestamp();
 
+		bool Verify(ModulesInterface *interface, int &errorCode);
 		bool Process(ModulesInterface *interface, int &errorCode);
 		void Execute(std::vector<std::pair<std::string, uint64_t>> &from, std::vector<std::pair<std::string, uint64_t>> &to) {}
 
 		uint64_t GetValidity();
-		std::string GetSlot();
+		ByteViewStruct GetSlot();
 		std::string GetCore();
 
 		bool HasReceiver();
@@ -92,22 +97,24 @@ class ExecuteFutureTransaction : public FutureTransaction
 {
 	public:
 		ExecuteFutureTransaction(const char rawTx[]) : FutureTransaction(rawTx){}
+		ExecuteFutureTransaction(rapidjson::Document &document, std::shared_ptr<TransactionArena> arena) : FutureTransaction(document, arena){}
 		
 		bool IsTransaction();
 
+		bool Verify(ModulesInterface *interface, int &errorCode);
 		bool Process(ModulesInterface *interface, int &errorCode);
 		void Execute(std::vector<std::pair<std::string, uint64_t>> &from, std::vector<std::pair<std::string, uint64_t>> &to);
 
-		std::string GetFuture();
+		ByteViewStruct GetFuture();
 		std::string GetCore();
 
 		std::string GetOutboundAccount();
 		uint64_t GetOutboundFee();
-		std::string GetOutboundSignature();
+		ByteViewStruct GetOutboundSignature();
 
 		std::string GetInboundAccount();
 		uint64_t GetInboundFee();
-		std::string GetInboundSignature();
+		ByteViewStruct GetInboundSignature();
 
 		uint64_t GetFees();
 		uint64_t GetNetAmount();
@@ -35,11 +35,12 @@
  * UDC Validating Node.
  */
 
+#include <algorithm>
 #include <chrono>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <mutex>
-#include <queue>
 #include <string>
 #include <thread>
 #include <unordered_set>
@@ -47,88 +48,60 @@
 #include <vector>
 
 #include "balances.h"
+#include "configurations.h"
 #include "dao_manager.h"
 #include "das_manager.h"
 #include "codes.h"
 #include "entity.h"
+#include "execution_scheduler.h"
 #include "globals.h"
+#include "hash160.h"
 #include "ledger.h"
 #include "modules_interface.h"
 #include "network.h"
 #include "node.h"
 #include "processing.h"
 #include "publisher.h"
+#include "timer_wheel.h"
 #include "transaction.h"
 #include "transaction_dao.h"
 #include "transaction_das.h"
 #include "transaction_delayed.h"
 #include "transaction_future.h"
 #include "transactions_manager.h"
+#include "transactions_queue.h"
 #include "util.h"
+#include "verification_pool.h"
 
 
 TransactionsManager::TransactionsManager(Publisher *publisher) : publisher(publisher) {}
 
 void TransactionsManager::CleanUp() {
-	std::lock_guard<std::mutex> lock(dataMutex);
-
-	//empty rejection list
-	rejectionList.clear();
-
-	//find all the transactions in use
+	//Every other holder releases its transactions as soon as it is done, modules are only polled
 	std::unordered_set<std::string> inUse;
+	modulesMutex.lock();
+	inUse = managerDAO->InUse();
+	std::unordered_set<std::string> dasTransactions = managerDAS->InUse();
+	modulesMutex.unlock();
+	inUse.insert(dasTransactions.begin(), dasTransactions.end());
 
-	//Add those awaiting processing
-	std::queue<std::string> tempQueue(processingQueue);
-	while(!tempQueue.empty()) {
-		inUse.insert(tempQueue.front());
-		tempQueue.pop();
-	}
-
-	//Add Delayed Requests
-	inUse.insert(delayedTransactions.begin(), delayedTransactions.end());
-
-	//Add Future Authorizes
-	for(auto it = futureTransactions.begin(); it != futureTransactions.end(); ++it) inUse.insert(it->first);
-
-	//Add DAO transactions in use
-	std::unordered_set<std::string> daoTransactions = managerDAO->InUse();
-	for(auto it = daoTransactions.begin(); it != daoTransactions.end(); ++it) inUse.insert(*it);
+	//One shard at a time, the others keep running
+	for(uint i = 0; i < TRANSACTIONS_SHARDS; i++) {
+		TransactionsShardStruct &shard = shards[i];
+		std::lock_guard<std::mutex> lock(shard.shardMutex);
 
-	//Add DAS transactions in use
-	std::unordered_set<std::string> dasTransactions = managerDAS->InUse();
-	for(auto it = dasTransactions.begin(); it != dasTransactions.end(); ++it) inUse.insert(*it);
+		//empty rejection list
+		shard.rejectionList.clear();
 
-	//clean up confirmation list
-	auto currIt = currentTransactions.end();
-	auto now = Util::current_timestamp_nanos();
-	
-	for(auto it = confirmationList.begin(); it != confirmationList.end(); ++it) {
-		//remove registered
-		if(it->second.first <= -1) confirmationList.erase(it->first);
-		else {
-			currIt = currentTransactions.find(it->first);
-			if(currIt != currentTransactions.end() && (currIt->second->GetTimestamp() + LEDGER_CLOSING_INTERVAL) < now) {
-				//Decrement reputation for the bad confirmations
-				nodes->UpdateReputation(it->second.second, false);
-				//remove expired unconfirmed
-				confirmationList.erase(it->first);
+		for(auto it = shard.moduleTransactions.begin(); it != shard.moduleTransactions.end();) {
+			if(inUse.find(it->ToHex()) != inUse.end()) {
+				++it;
+				continue;
 			}
-			//Add those awaiting confirmation
-			else inUse.insert(it->first);
-		}
-	}
-
-	//Add those pending registration
-	for(auto it = registrationList.begin(); it != registrationList.end(); ++it) inUse.insert(it->second);
 
-	//Finally, remove all that aren't needed
-	for(auto it = currentTransactions.begin(); it != currentTransactions.end(); ++it) {
-		auto it2 = inUse.find(it->first);
-		if(it2 == inUse.end()) {
-			//delete the actual transaction object
-			delete it->second;
-			currentTransactions.erase(it->first);
+			Hash160 hash = *it;
+			it = shard.moduleTransactions.erase(it);
+			Release(shard, hash, HOLD_MODULE);
 		}
 	}
 }
@@ -138,164 +111,331 @@ void TransactionsManager::ProcessTransactions(bool *IS_OPERATING, Balances *bala
 	this->managerDAO = managerDAO;
 	this->managerDAS = managerDAS;
 	this->ledger = ledger;
+	this->interface = interface;
 	this->nodes = nodes;
 	
-	std::vector<std::pair<std::string, uint64_t>> senders, receivers;
-	std::string hash, event;
+	std::vector<ExecutionStruct> batch;
+	std::vector<std::pair<Hash160, Transaction*>> submissions;
+	std::vector<std::string> accounts;
+	Hash160 hash;
+	Transaction *transaction;
 	int errorCode;
 	uint type;
 
+	//stateless checks run in parallel, balances are applied by conflict groups
+	VerificationPool verificationPool(interface, _VERIFICATION_WORKERS);
+	ExecutionScheduler scheduler(std::bind(&TransactionsManager::ExecuteTransaction, this, std::placeholders::_1), _EXECUTION_WORKERS);
+
 	while(*IS_OPERATING) {
-		if(!processingQueue.empty()) {
-			hash = processingQueue.front();
-			processingQueue.pop();
+		//No execution is running, free the transactions retired meanwhile
+		Reclaim();
 
-			errorCode = VALID;
-			type = std::stoul(currentTransactions[hash]->GetType(),nullptr,16);
+		//Balances match the operations journaled so far, a consistent point to persist them
+		if(balancesDB->FlushDue()) {
+			std::lock_guard<std::mutex> lock(executionMutex);
+			balancesDB->Flush(std::bind(&Ledger::JournalPosition, ledger));
+		}
 
-			//Process transaction accordingly 
-			switch(type) {
-				case TRANSACTION_BASIC:
-					currentTransactions[hash]->Process(interface, errorCode);
-					break;
+		//Hand queued transactions to the verification workers, blocking only when there is nothing else to do
+		while(verificationPool.Pending() + submissions.size() < TRANSACTION_VERIFICATION_WINDOW) {
+			if(verificationPool.Pending() || !submissions.empty()) {
+				if(!processingQueue.Pop(hash)) break;
+			}
+			else if(!processingQueue.Wait(hash)) break;
 
-				case TRANSACTION_DELAYED:
-					event = dynamic_cast<DelayedTransaction*>(currentTransactions[hash])->GetEvent();
-					if(event == TX_DELAYED_REQUEST) currentTransactions[hash]->Process(interface, errorCode);
-					else if (event == TX_DELAYED_RELEASE) currentTransactions[hash]->Process(interface, errorCode);
-					break;
+			transaction = Claim(hash);
+			if(transaction) submissions.push_back(std::make_pair(hash, transaction));
+		}
 
-				case TRANSACTION_FUTURE:
-					event = dynamic_cast<FutureTransaction*>(currentTransactions[hash])->GetEvent();
-					if(event == TX_FUTURE_AUTHORIZE) currentTransactions[hash]->Process(interface, errorCode);
-					else if (event == TX_FUTURE_EXECUTE) currentTransactions[hash]->Process(interface, errorCode);
-					break;
+		//their senders' keys are read together beforehand
+		for(auto submission = submissions.begin(); submission != submissions.end(); ++submission) accounts.push_back(submission->second->GetSender());
+		interface->PrefetchPublicKeys(accounts);
+		for(auto submission = submissions.begin(); submission != submissions.end(); ++submission) verificationPool.Submit(submission->first, submission->second);
+		submissions.clear();
+		accounts.clear();
 
-				case TRANSACTION_DAO:
-					managerDAO->Process(dynamic_cast<DAOTransaction*>(currentTransactions[hash]), errorCode);
-					break;
+		//Collect verified transactions in their arrival order, only waiting for the first one
+		while(batch.size() < TRANSACTION_EXECUTION_BATCH && verificationPool.Next(hash, errorCode, batch.empty() ? TRANSACTION_QUEUE_WAIT : 0)) {
+			transaction = Claim(hash);
+			if(!transaction) continue;
+			transaction->Stamp(STAGE_VERIFIED);
 
-				case TRANSACTION_DAS:
-					managerDAS->Process(dynamic_cast<DASTransaction*>(currentTransactions[hash]), errorCode);
-					break;
+			type = std::stoul(transaction->GetType(),nullptr,16);
+			batch.push_back({hash, transaction, type, errorCode, type != TRANSACTION_BASIC});
 
-				default:
-					errorCode = ERROR_UNSUPPORTED_TYPE;
-					break;
+			//retrieve monetary movements
+			if(errorCode == VALID) transaction->Execute(batch.back().senders, batch.back().receivers);
+		}
+		if(batch.empty()) continue;
+
+		//Read the balances the whole batch debits at once
+		for(auto execution = batch.begin(); execution != batch.end(); ++execution) {
+			if(execution->errorCode != VALID) continue;
+			for(auto f = execution->senders.begin(); f != execution->senders.end(); ++f) {
+				if(f->first != WORLD_BANK_ACCOUNT) accounts.push_back(f->first);
 			}
+		}
+		balancesDB->Prefetch(accounts);
+		accounts.clear();
 
-			//Execute monetary transfers
-			if(errorCode == VALID) {
-				//retrieve monetary movements
-				currentTransactions[hash]->Execute(senders, receivers);
+		//Apply them, transactions touching unrelated accounts concurrently
+		executionMutex.lock();
 
-				//Certify amounts of special transactions
-				if(type == TRANSACTION_DAO) {
-					if(!managerDAO->Allow(dynamic_cast<DAOTransaction*>(currentTransactions[hash])->GetDAO(), senders, receivers, errorCode)) errorCode = ERROR_INSUFICIENT_FUNDS;
-				}
-				else if(type == TRANSACTION_DAS) {
-					if(!managerDAS->Allow(dynamic_cast<DASTransaction*>(currentTransactions[hash])->GetDAS(), senders, receivers, errorCode)) errorCode = ERROR_INSUFICIENT_FUNDS;
-				}
+		//a ledger rollback may have taken some of them out since they were collected
+		batch.erase(std::remove_if(batch.begin(), batch.end(), [this](const ExecutionStruct &execution) { return !Claim(execution.hash); }), batch.end());
+		if(batch.empty()) {
+			executionMutex.unlock();
+			continue;
+		}
+		scheduler.Execute(batch);
 
-				//update balances
-				if(VALID && !balancesDB->UpdateBalances(senders, receivers)) errorCode = ERROR_INSUFICIENT_FUNDS;
-				//register operations
-				else ledger->RegisterMovements(currentTransactions[hash]->GetTimestamp(), senders, receivers);
-			}
+		//register operations in arrival order, a rollback finds the journals in line with the balances
+		for(auto execution = batch.begin(); execution != batch.end(); ++execution) {
+			if(execution->errorCode == VALID) ledger->RegisterMovements(execution->transaction->GetTimestamp(), execution->senders, execution->receivers);
+		}
+		executionMutex.unlock();
+
+		//Report the results in arrival order
+		for(auto execution = batch.begin(); execution != batch.end(); ++execution) {
+			hash = execution->hash;
+			execution->transaction->Stamp(STAGE_EXECUTED);
+
+			//queue confirmation for the next batch sent to all peer nodes
+			if(execution->errorCode == VALID) nodes->QueueConfirmation(hash, execution->transaction->IsMeasured());
+
+			TransactionsShardStruct &shard = Shard(hash);
+			std::lock_guard<std::mutex> lock(shard.shardMutex);
 
-			dataMutex.lock();
 			//Inform Managing Entity of the validation result
-			auto it = submissionList.find(hash);
-			if(it != submissionList.end()) {
-				entities->TransactionReply(it->second, hash, errorCode);
-				submissionList.erase(hash);
+			auto it = shard.submissionList.find(hash);
+			if(it != shard.submissionList.end()) {
+				entities->TransactionReply(it->second, hash.ToHex(), execution->errorCode);
+				admission.Complete(it->second);
+				shard.submissionList.erase(it);
 			}
 
-			if(errorCode == VALID) {
-				switch(type) {
-					case TRANSACTION_DELAYED:
-						if (dynamic_cast<DelayedTransaction*>(currentTransactions[hash])->GetEvent() == TX_DELAYED_RELEASE) {
-							//Remove related Delayed Request
-							delayedTransactions.erase(dynamic_cast<ReleaseDelayedTransaction*>(currentTransactions[hash])->GetRequest());
-						}
-						break;
+			//add an invalid transaction to the rejection list
+			if(execution->errorCode != VALID) {
+				shard.rejectionList.insert(hash);
+				seen.Insert(hash);
+			}
 
-					case TRANSACTION_FUTURE:
-						if(dynamic_cast<FutureTransaction*>(currentTransactions[hash])->GetEvent() == TX_FUTURE_EXECUTE) {
-							//Remove related Future Authorize
-							futureTransactions.erase(dynamic_cast<ExecuteFutureTransaction*>(currentTransactions[hash])->GetFuture());
-						}
-						break;
+			//Done processing, a rejected transaction won't be confirmed either
+			Release(shard, hash, execution->errorCode == VALID ? HOLD_PROCESSING : HOLD_PROCESSING | HOLD_CONFIRMATION);
+		}
+		batch.clear();
+	}
 
-					case TRANSACTION_DAO:
-						//Let DAO manager register the validated transaction
-						managerDAO->Register(dynamic_cast<DAOTransaction*>(currentTransactions[hash]));
-						break;
+	//Shutting down, don't leave anything to replay
+	std::lock_guard<std::mutex> lock(executionMutex);
+	balancesDB->Flush(std::bind(&Ledger::JournalPosition, ledger));
+}
 
-					case TRANSACTION_DAS:
-						//Let DAS manager register the validated transaction
-						managerDAS->Register(dynamic_cast<DASTransaction*>(currentTransactions[hash]));
-						break;
+void TransactionsManager::ExecuteTransaction(ExecutionStruct &execution) {
+	Transaction *transaction = execution.transaction;
+	int &errorCode = execution.errorCode;
+	std::string event;
+	Hash160 reference;
 
-					default: break;
-				}
+	//Process transaction accordingly 
+	switch(execution.type) {
+		case TRANSACTION_BASIC:
+			transaction->Process(interface, errorCode);
+			break;
+
+		case TRANSACTION_DELAYED:
+			event = dynamic_cast<DelayedTransaction*>(transaction)->GetEvent();
+			if(event == TX_DELAYED_REQUEST) transaction->Process(interface, errorCode);
+			else if (event == TX_DELAYED_RELEASE) transaction->Process(interface, errorCode);
+			break;
+
+		case TRANSACTION_FUTURE:
+			event = dynamic_cast<FutureTransaction*>(transaction)->GetEvent();
+			if(event == TX_FUTURE_AUTHORIZE) transaction->Process(interface, errorCode);
+			else if (event == TX_FUTURE_EXECUTE) transaction->Process(interface, errorCode);
+			break;
+
+		case TRANSACTION_DAO:
+			managerDAO->Process(dynamic_cast<DAOTransaction*>(transaction), errorCode);
+			break;
+
+		case TRANSACTION_DAS:
+			managerDAS->Process(dynamic_cast<DASTransaction*>(transaction), errorCode);
+			break;
+
+		default:
+			errorCode = ERROR_UNSUPPORTED_TYPE;
+			break;
+	}
+	if(errorCode != VALID) return;
+
+	//Certify amounts of special transactions
+	if(execution.type == TRANSACTION_DAO) {
+		if(!managerDAO->Allow(dynamic_cast<DAOTransaction*>(transaction)->GetDAO(), execution.senders, execution.receivers, errorCode)) errorCode = ERROR_INSUFICIENT_FUNDS;
+	}
+	else if(execution.type == TRANSACTION_DAS) {
+		if(!managerDAS->Allow(dynamic_cast<DASTransaction*>(transaction)->GetDAS(), execution.senders, execution.receivers, errorCode)) errorCode = ERROR_INSUFICIENT_FUNDS;
+	}
+	if(errorCode != VALID) return;
+
+	//update balances
+	if(!balancesDB->UpdateBalances(execution.senders, execution.receivers)) {
+		errorCode = ERROR_INSUFICIENT_FUNDS;
+		return;
+	}
 
-				//broadcasts confirmation to all peer nodes
-				nodes->BroadcastConfirmation(hash, true);
+	//Update the state following transactions depend on, these always run alone
+	switch(execution.type) {
+		case TRANSACTION_DELAYED:
+			if (dynamic_cast<DelayedTransaction*>(transaction)->GetEvent() == TX_DELAYED_RELEASE && Hash160::FromHex(dynamic_cast<ReleaseDelayedTransaction*>(transaction)->GetRequest().ToString(), reference)) {
+				//Remove related Delayed Request
+				TransactionsShardStruct &shard = Shard(reference);
+				std::lock_guard<std::mutex> lock(shard.shardMutex);
+				shard.delayedTransactions.erase(reference);
+				timers.Cancel(reference, TIMER_DELAYED_EXPIRATION);
+				Release(shard, reference, HOLD_DELAYED);
 			}
-			//Otherwise add the invalid transaction to the rejection list
-			else rejectionList.insert(hash);
+			break;
+
+		case TRANSACTION_FUTURE:
+			if(dynamic_cast<FutureTransaction*>(transaction)->GetEvent() == TX_FUTURE_EXECUTE && Hash160::FromHex(dynamic_cast<ExecuteFutureTransaction*>(transaction)->GetFuture().ToString(), reference)) {
+				//Remove related Future Authorize
+				TransactionsShardStruct &shard = Shard(reference);
+				std::lock_guard<std::mutex> lock(shard.shardMutex);
+				shard.futureTransactions.erase(reference);
+				timers.Cancel(reference, TIMER_FUTURE_EXPIRATION);
+				Release(shard, reference, HOLD_FUTURE);
+			}
+			break;
+
+		case TRANSACTION_DAO: {
+			//Let DAO manager register the validated transaction
+			std::lock_guard<std::mutex> lock(modulesMutex);
+			managerDAO->Register(dynamic_cast<DAOTransaction*>(transaction));
+			break;
+		}
+
+		case TRANSACTION_DAS: {
+			//Let DAS manager register the validated transaction
+			std::lock_guard<std::mutex> lock(modulesMutex);
+			managerDAS->Register(dynamic_cast<DASTransaction*>(transaction));
+			break;
 		}
 
-		else std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		default: break;
 	}
 }
 
 void TransactionsManager::TransactionsRegistration(bool *IS_OPERATING) {
-	std::string hash;
+	std::vector<TimerStruct> expired;
 
 	while(*IS_OPERATING) {
-		if(!registrationList.empty()) {
-			auto now = Util::current_timestamp_nanos();
+		timers.Wait();
+
+		expired.clear();
+		timers.Advance(Util::current_timestamp_nanos(), expired);
 
-			if(registrationList.front().first + TRANSACTION_DELAY_REGISTRATION > now) {
-				hash = registrationList.front().second;
-				ledger->RegisterTransaction(currentTransactions[hash]);
-				registrationList.pop_front();
+		for(auto it = expired.begin(); it != expired.end(); ++it) {
+			if(it->type != TIMER_REGISTRATION) {
+				ExpireTransaction(*it);
+				continue;
 			}
+
+			//Register it into the ledger
+			Transaction *transaction = Lookup(it->hash);
+			if(!transaction) continue;
+			ledger->RegisterTransaction(transaction);
+			transaction->Stamp(STAGE_REGISTERED);
+
+			TransactionsShardStruct &shard = Shard(it->hash);
+			std::lock_guard<std::mutex> lock(shard.shardMutex);
+			Release(shard, it->hash, HOLD_REGISTRATION);
 		}
+	}
+}
+
+void TransactionsManager::ExpireTransaction(TimerStruct &timer) {
+	TransactionsShardStruct &shard = Shard(timer.hash);
+	std::lock_guard<std::mutex> lock(shard.shardMutex);
 
-		else std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	switch(timer.type) {
+		case TIMER_DELAYED_EXPIRATION:
+			shard.delayedTransactions.erase(timer.hash);
+			Release(shard, timer.hash, HOLD_DELAYED);
+			break;
+
+		case TIMER_FUTURE_EXPIRATION:
+			shard.futureTransactions.erase(timer.hash);
+			Release(shard, timer.hash, HOLD_FUTURE);
+			break;
+
+		case TIMER_CONFIRMATION_EXPIRATION: {
+			auto it = shard.confirmationList.find(timer.hash);
+			if(it != shard.confirmationList.end()) {
+				//Decrement reputation for the bad confirmations of an expired unconfirmed transaction
+				if(it->second.first > -1 && shard.currentTransactions.find(timer.hash) != shard.currentTransactions.end()) nodes->UpdateReputation(it->second.second, false);
+				shard.confirmationList.erase(it);
+			}
+			Release(shard, timer.hash, HOLD_CONFIRMATION);
+			break;
+		}
+
+		default: break;
 	}
 }
 
+bool TransactionsManager::AdmitSubmission(std::string entityId, int &errorCode) {
+	return admission.Admit(entityId, processingQueue.Depth(), errorCode);
+}
+
+void TransactionsManager::CancelSubmission(std::string entityId) {
+	admission.Complete(entityId);
+}
+
+bool TransactionsManager::IsKnown(const Hash160 &hash) {
+	//Most hashes never seen before stop here, without locking
+	if(!seen.MayContain(hash)) return false;
+
+	TransactionsShardStruct &shard = Shard(hash);
+	std::lock_guard<std::mutex> lock(shard.shardMutex);
+	return shard.currentTransactions.find(hash) != shard.currentTransactions.end() || shard.rejectionList.find(hash) != shard.rejectionList.end();
+}
+
 bool TransactionsManager::AddTransaction(Transaction *transaction, int &errorCode, bool process /*=false*/, uint dispatcher /*=DISPATCHER_NODE*/, std::string dispatcherId /*=""*/) {
-	std::lock_guard<std::mutex> lock(dataMutex);
-	std::string hash = transaction->GetHash();
+	Hash160 hash = transaction->GetDigest();
+	TransactionsShardStruct &shard = Shard(hash);
+	std::lock_guard<std::mutex> lock(shard.shardMutex);
 
-	auto it1 = currentTransactions.find(hash);
-	if(it1 != currentTransactions.end()) {
+	auto it1 = shard.currentTransactions.find(hash);
+	if(it1 != shard.currentTransactions.end()) {
 		errorCode = ERROR_TRANSACTION_DUPLICATE;
 		delete transaction;
 		return false;
 	}
 
-	auto it2 = rejectionList.find(hash);
-	if(it2 != rejectionList.end()) {
+	auto it2 = shard.rejectionList.find(hash);
+	if(it2 != shard.rejectionList.end()) {
 		errorCode = ERROR_TRANSACTION_REJECTED;
 		delete transaction;
 		return false;
 	}
 
-	currentTransactions[hash] = transaction;
+	shard.currentTransactions[hash] = transaction;
 
 	if(process) {
-		processingQueue.push(hash);
-		
+		//refuse it while the processing thread is saturated
+		if(!processingQueue.Push(hash)) {
+			shard.currentTransactions.erase(hash);
+			errorCode = ERROR_TRANSACTION_QUEUE_FULL;
+			delete transaction;
+			return false;
+		}
+		Hold(shard, hash, HOLD_PROCESSING);
+
 		switch(dispatcher) {
 			case DISPATCHER_ENTITY:
 				nodes->BroadcastNewTransaction(transaction);
-				submissionList[hash] = dispatcherId;
+				shard.submissionList[hash] = dispatcherId;
 				break;
 
 			case DISPATCHER_DAO:
@@ -306,27 +446,42 @@ bool TransactionsManager::AddTransaction(Transaction *transaction, int &errorCod
 			default: break;
 		}
 	}
-	else {
+
+	//Keep it until confirmed, or given up on
+	seen.Insert(hash);
+	Hold(shard, hash, HOLD_CONFIRMATION);
+	timers.Schedule(hash, TIMER_CONFIRMATION_EXPIRATION, transaction->GetTimestamp() + LEDGER_CLOSING_INTERVAL);
+
+	if(!process) {
 		//Check if we requested it
-		auto it3 = missingList.find(hash);
-		if(it3 != missingList.end()) {
-			missingList.erase(hash);
+		auto it3 = shard.missingList.find(hash);
+		if(it3 != shard.missingList.end()) {
+			shard.missingList.erase(it3);
 
 			//Verify if it already has enough confirmations to be registered
-			IsConfirmed(hash);
+			IsConfirmed(shard, hash);
 		}
 	}
 	return true;
 }
 
 void TransactionsManager::FailedToFetch(std::string hash) {
-	//Check if we requested it
-	auto it = missingList.find(hash);
-	if(it == missingList.end()) return;
+	Hash160 id;
+	if(!Hash160::FromHex(hash, id)) return;
+	TransactionsShardStruct &shard = Shard(id);
+	int requests;
 
-	missingList[hash]++;
+	//Check if we requested it
+	shard.shardMutex.lock();
+	auto it = shard.missingList.find(id);
+	if(it == shard.missingList.end()) {
+		shard.shardMutex.unlock();
+		return;
+	}
+	requests = ++it->second;
+	shard.shardMutex.unlock();
 
-	if(missingList[hash] > MAX_DATA_REQUESTS) {
+	if(requests > MAX_DATA_REQUESTS) {
 		std::string message = std::to_string(TRACKER_CODE_TRANSACTION) + std::to_string(TRACKER_GET_BY_HASH) + hash;
 
 		//Request a Tracker for the transaction
@@ -373,32 +528,45 @@ void TransactionsManager::FailedToFetch(std::string hash) {
 }
 
 void TransactionsManager::AddConfirmation(std::string hash, std::string node) {
-	std::lock_guard<std::mutex> lock(dataMutex);
-	confirmationList[hash].first++;
-	confirmationList[hash].second.push_back(node);
+	Hash160 id;
+	if(Hash160::FromHex(hash, id)) AddConfirmation(id, node);
+}
+
+void TransactionsManager::AddConfirmation(const Hash160 &id, std::string node) {
+	TransactionsShardStruct &shard = Shard(id);
+	std::lock_guard<std::mutex> lock(shard.shardMutex);
+	auto it = shard.confirmationList.find(id);
+	if(it == shard.confirmationList.end()) {
+		timers.Schedule(id, TIMER_CONFIRMATION_EXPIRATION, Util::current_timestamp_nanos() + LEDGER_CLOSING_INTERVAL);
+		it = shard.confirmationList.emplace(id, std::make_pair(0, std::vector<std::string>())).first;
+	}
+	it->second.first++;
+	it->second.second.push_back(node);
 
 	//Request the transaction if we don't have it
-	auto it = currentTransactions.find(hash);
-	if(it == currentTransactions.end()) {
-		missingList[hash] = 0;
+	if(shard.currentTransactions.find(id) == shard.currentTransactions.end()) {
+		shard.missingList[id] = 0;
 		int errorCode;
 		boost::asio::ip::tcp::socket *socket = nodes->WriteToNode(node, errorCode);
-		if(!errorCode) Network::WriteMessage(*socket, NETWORK_GET_TRANSACTION, hash, true);
+		if(!errorCode) Network::WriteMessage(*socket, NETWORK_GET_TRANSACTION, id.ToHex(), true);
 		return;
 	}
 
-	IsConfirmed(hash);
+	IsConfirmed(shard, id);
 }
 
-bool TransactionsManager::IsConfirmed(std::string hash) {
-	int threshold, type = std::stoul(currentTransactions[hash]->GetType(), nullptr, 16);
+bool TransactionsManager::IsConfirmed(TransactionsShardStruct &shard, Hash160 hash) {
+	Transaction *transaction = shard.currentTransactions[hash];
+	auto &confirmations = shard.confirmationList[hash];
+
+	int threshold, type = std::stoul(transaction->GetType(), nullptr, 16);
 	switch(type) {
 		case TRANSACTION_DAO:
-			threshold = managerDAO->ConfirmationThreshold(dynamic_cast<DAOTransaction*>(currentTransactions[hash])->GetDAO());
+			threshold = managerDAO->ConfirmationThreshold(dynamic_cast<DAOTransaction*>(transaction)->GetDAO());
 			break;
 
 		case TRANSACTION_DAS:
-			threshold = managerDAS->ConfirmationThreshold(dynamic_cast<DASTransaction*>(currentTransactions[hash])->GetDAS());
+			threshold = managerDAS->ConfirmationThreshold(dynamic_cast<DASTransaction*>(transaction)->GetDAS());
 			break;
 
 		default:
@@ -406,34 +574,31 @@ bool TransactionsManager::IsConfirmed(std::string hash) {
 			break;
 	}
 
-	std::lock_guard<std::mutex> lock(dataMutex);
-
-	if(confirmationList[hash].first >= threshold) {
-		confirmationList[hash].first = -32767;
+	if(confirmations.first >= threshold) {
+		confirmations.first = -32767;
+		transaction->Stamp(STAGE_CONFIRMED);
 
-		//insert the transaction ordered by its timestamp
-		if(!registrationList.empty()) {
-			for(auto regIt = registrationList.end(); regIt != registrationList.begin(); --regIt) {
-				if(regIt->first <= currentTransactions[hash]->GetTimestamp()) {
-					registrationList.insert(regIt, {currentTransactions[hash]->GetTimestamp(), hash});
-					break;
-				}
-			}
-		}
-		else registrationList.push_front({currentTransactions[hash]->GetTimestamp(), hash});
+		//register the transaction once its timestamp is old enough
+		timers.Schedule(hash, TIMER_REGISTRATION, transaction->GetTimestamp() + TRANSACTION_DELAY_REGISTRATION);
+		Hold(shard, hash, HOLD_REGISTRATION);
 
 		bool keep = false;
 		switch(type) {
 			case TRANSACTION_DELAYED:
-				if(dynamic_cast<DelayedTransaction*>(currentTransactions[hash])->GetEvent() == TX_DELAYED_REQUEST) {
-					delayedTransactions.insert(hash);
+				if(dynamic_cast<DelayedTransaction*>(transaction)->GetEvent() == TX_DELAYED_REQUEST) {
+					shard.delayedTransactions.insert(hash);
+					timers.Schedule(hash, TIMER_DELAYED_EXPIRATION, dynamic_cast<RequestDelayedTransaction*>(transaction)->GetExecution() + TRANSACTION_DELAY_NEW);
+					Hold(shard, hash, HOLD_DELAYED);
 					keep = true;
 				}
 				break;
 
 			case TRANSACTION_FUTURE:
-				if(dynamic_cast<FutureTransaction*>(currentTransactions[hash])->GetEvent() == TX_FUTURE_AUTHORIZE) {
-					futureTransactions[hash] = dynamic_cast<AuthorizeFutureTransaction*>(currentTransactions[hash])->GetValidity();
+				if(dynamic_cast<FutureTransaction*>(transaction)->GetEvent() == TX_FUTURE_AUTHORIZE) {
+					uint64_t validity = dynamic_cast<AuthorizeFutureTransaction*>(transaction)->GetValidity();
+					shard.futureTransactions[hash] = validity;
+					timers.Schedule(hash, TIMER_FUTURE_EXPIRATION, validity + TRANSACTION_DELAY_NEW);
+					Hold(shard, hash, HOLD_FUTURE);
 					keep = true;
 				}
 				break;
@@ -441,30 +606,134 @@ bool TransactionsManager::IsConfirmed(std::string hash) {
 			default: break;
 		}
 
-		//Let DAOs and DASs lookup the transaction, delete if its unused
-		if(!keep && !managerDAO->Enroll(currentTransactions[hash]) && !managerDAS->Enroll(currentTransactions[hash])) delete currentTransactions[hash];
+		//Let DAOs and DASs lookup the transaction
+		if(!keep) EnrollTransaction(shard, hash, transaction);
 
 		//Increment reputation of the nodes that correctly confirmed this transaction
-		nodes->UpdateReputation(confirmationList[hash].second, true);
-		confirmationList[hash].second.clear();
+		nodes->UpdateReputation(confirmations.second, true);
+		confirmations.second.clear();
 
 		//publish transaction
 		int counter = 0;
-		while(!publisher->PublishTransaction("{\"" + hash + "\":" + currentTransactions[hash]->GetTransaction()+"}") && counter < 3) counter++;
+		while(!publisher->PublishTransaction("{\"" + hash.ToHex() + "\":" + transaction->GetTransaction()+"}") && counter < 3) counter++;
+		transaction->Stamp(STAGE_PUBLISHED);
 
+		//No longer awaiting confirmations
+		Release(shard, hash, HOLD_CONFIRMATION);
 		return true;
 	}
 	return false;
 }
 
-void TransactionsManager::RollbackTransaction(Transaction *transaction) {
-	auto it = currentTransactions.find(transaction->GetHash());
-	if(it != currentTransactions.end()) {
-		delete it->second;
-		currentTransactions.erase(transaction->GetHash());
+bool TransactionsManager::EnrollTransaction(TransactionsShardStruct &shard, Hash160 hash, Transaction *transaction) {
+	modulesMutex.lock();
+	bool enrolled = managerDAO->Enroll(transaction) || managerDAS->Enroll(transaction);
+	modulesMutex.unlock();
+	if(!enrolled) return false;
+
+	//Modules keep the pointer, hold it until they no longer report it in use
+	shard.currentTransactions[hash] = transaction;
+	shard.moduleTransactions.insert(hash);
+	Hold(shard, hash, HOLD_MODULE);
+	return true;
+}
+
+void TransactionsManager::Hold(TransactionsShardStruct &shard, Hash160 hash, uint reason) {
+	shard.holds[hash] |= reason;
+}
+
+void TransactionsManager::Release(TransactionsShardStruct &shard, Hash160 hash, uint reason) {
+	auto it = shard.holds.find(hash);
+	if(it == shard.holds.end()) return;
+
+	it->second &= ~reason;
+	if(!it->second) Retire(shard, hash);
+}
+
+void TransactionsManager::Retire(TransactionsShardStruct &shard, Hash160 hash) {
+	shard.holds.erase(hash);
+	shard.moduleTransactions.erase(hash);
+	shard.rolledBack.erase(hash);
+
+	//A submission dropped before its reply no longer counts against its entity
+	auto submission = shard.submissionList.find(hash);
+	if(submission != shard.submissionList.end()) {
+		admission.Complete(submission->second);
+		shard.submissionList.erase(submission);
+	}
+
+	auto it = shard.currentTransactions.find(hash);
+	if(it == shard.currentTransactions.end()) return;
+
+	//Executions may still be reading it, free it at the next batch boundary
+	shard.retiredTransactions.push_back(it->second);
+	shard.currentTransactions.erase(it);
+}
+
+void TransactionsManager::Reclaim() {
+	std::vector<Transaction*> retired;
+
+	for(uint i = 0; i < TRANSACTIONS_SHARDS; i++) {
+		shards[i].shardMutex.lock();
+		retired.insert(retired.end(), shards[i].retiredTransactions.begin(), shards[i].retiredTransactions.end());
+		shards[i].retiredTransactions.clear();
+		shards[i].shardMutex.unlock();
+	}
+
+	for(auto it = retired.begin(); it != retired.end(); ++it) delete *it;
+}
+
+TransactionsShardStruct& TransactionsManager::Shard(const Hash160 &hash) {
+	//trailing byte, the leading ones already pick the buckets inside the shard
+	return shards[hash.bytes[HASH160_LENGTH-1] % TRANSACTIONS_SHARDS];
+}
+
+Transaction* TransactionsManager::Lookup(const Hash160 &hash) {
+	TransactionsShardStruct &shard = Shard(hash);
+	std::lock_guard<std::mutex> lock(shard.shardMutex);
+
+	auto it = shard.currentTransactions.find(hash);
+	if(it == shard.currentTransactions.end()) return nullptr;
+	return it->second;
+}
+
+Transaction* TransactionsManager::Claim(const Hash160 &hash) {
+	TransactionsShardStruct &shard = Shard(hash);
+	std::lock_guard<std::mutex> lock(shard.shardMutex);
+
+	//no verification is using it anymore, it's freed at the next batch boundary
+	if(shard.rolledBack.erase(hash)) {
+		Retire(shard, hash);
+		return nullptr;
+	}
+
+	auto it = shard.currentTransactions.find(hash);
+	if(it == shard.currentTransactions.end()) return nullptr;
+	return it->second;
+}
+
+void TransactionsManager::RollbackTransaction(Transaction *transaction, bool revertBalances /*=true*/) {
+	Hash160 hash = transaction->GetDigest();
+	TransactionsShardStruct &shard = Shard(hash);
+
+	//Drop our own copy, freed once no execution can still be using it
+	shard.shardMutex.lock();
+	timers.Cancel(hash, TIMER_REGISTRATION);
+	timers.Cancel(hash, TIMER_CONFIRMATION_EXPIRATION);
+
+	auto held = shard.holds.find(hash);
+	if(held != shard.holds.end() && (held->second & HOLD_PROCESSING)) {
+		//still queued or being verified, the processing thread skips and retires it once done
+		held->second = HOLD_PROCESSING;
+		shard.moduleTransactions.erase(hash);
+		shard.rolledBack.insert(hash);
 	}
+	else Retire(shard, hash);
+	shard.shardMutex.unlock();
+
 	std::vector<std::pair<std::string, uint64_t>> from, to;
 	std::string event;
+	Hash160 future;
 
 	//Rollback operations
 	//Step 1: retrieve transaction's monetary transfers
@@ -472,74 +741,99 @@ void TransactionsManager::RollbackTransaction(Transaction *transaction) {
 	//Step 3: revert transfers within balances database
 	//Step 4: undo transaction's actions
 
-	switch(std::stoul((it->second)->GetType(), nullptr, 16)) {
+	switch(std::stoul(transaction->GetType(), nullptr, 16)) {
 		case TRANSACTION_BASIC:
 			transaction->Execute(from, to); //Step 1
 			ledger->RegisterMovements(transaction->GetTimestamp(), to, from); //Step 2
-			balancesDB->RollbackBalances(from, to); //Step 3
+			if(revertBalances) balancesDB->RollbackBalances(from, to); //Step 3
 			break;
 
 		case TRANSACTION_DELAYED:
 			event = dynamic_cast<DelayedTransaction*>(transaction)->GetEvent();
-			if(event == TX_DELAYED_REQUEST) delayedTransactions.erase(transaction->GetHash()); //Step 4
+			if(event == TX_DELAYED_REQUEST) { //Step 4
+				std::lock_guard<std::mutex> lock(shard.shardMutex);
+				shard.delayedTransactions.erase(hash);
+				timers.Cancel(hash, TIMER_DELAYED_EXPIRATION);
+			}
 
 			transaction->Execute(from, to); //Step 1
 			ledger->RegisterMovements(transaction->GetTimestamp(), to, from); //Step 2
-			balancesDB->RollbackBalances(from, to); //Step 3
+			if(revertBalances) balancesDB->RollbackBalances(from, to); //Step 3
 			break;
 
 		case TRANSACTION_FUTURE:
 			event = dynamic_cast<FutureTransaction*>(transaction)->GetEvent();
-			if(event == TX_FUTURE_AUTHORIZE) futureTransactions.erase(transaction->GetHash()); //Step 4
+			if(event == TX_FUTURE_AUTHORIZE) { //Step 4
+				std::lock_guard<std::mutex> lock(shard.shardMutex);
+				shard.futureTransactions.erase(hash);
+				timers.Cancel(hash, TIMER_FUTURE_EXPIRATION);
+			}
 
-			else if(event == TX_FUTURE_EXECUTE) {
+			else if(event == TX_FUTURE_EXECUTE && Hash160::FromHex(dynamic_cast<ExecuteFutureTransaction*>(transaction)->GetFuture().ToString(), future)) {
 				//Step 4
-				auto it2 = currentTransactions.find(dynamic_cast<ExecuteFutureTransaction*>(transaction)->GetFuture());
-				if(it2 != currentTransactions.end()) {
+				TransactionsShardStruct &futureShard = Shard(future);
+				std::lock_guard<std::mutex> lock(futureShard.shardMutex);
+
+				auto it2 = futureShard.currentTransactions.find(future);
+				if(it2 != futureShard.currentTransactions.end()) {
 					//Restore related Authorize if still valid
 					auto now = Util::current_timestamp_nanos();
 					uint64_t validity = dynamic_cast<AuthorizeFutureTransaction*>(it2->second)->GetValidity();
-					if(validity > now) futureTransactions[transaction->GetHash()] = validity;
+					if(validity > now) {
+						futureShard.futureTransactions[future] = validity;
+						timers.Schedule(future, TIMER_FUTURE_EXPIRATION, validity + TRANSACTION_DELAY_NEW);
+						Hold(futureShard, future, HOLD_FUTURE);
+					}
 				}
 			}
 			transaction->Execute(from, to); //Step 1
 			ledger->RegisterMovements(transaction->GetTimestamp(), to, from); //Step 2
-			balancesDB->RollbackBalances(from, to); //Step 3
+			if(revertBalances) balancesDB->RollbackBalances(from, to); //Step 3
 			break;
 
 		case TRANSACTION_DAO:
 			managerDAO->Execute(dynamic_cast<DAOTransaction*>(transaction), from, to); //Step 1
 			ledger->RegisterMovements(transaction->GetTimestamp(), to, from); //Step 2
+			modulesMutex.lock();
 			managerDAO->Rollback(dynamic_cast<DAOTransaction*>(transaction)); //Steps 3 and 4
+			modulesMutex.unlock();
 			break;
 
 		case TRANSACTION_DAS:
 			managerDAS->Execute(dynamic_cast<DASTransaction*>(transaction), from, to); //Step 1
 			ledger->RegisterMovements(transaction->GetTimestamp(), to, from); //Step 2
+			modulesMutex.lock();
 			managerDAS->Rollback(dynamic_cast<DASTransaction*>(transaction)); //Steps 3 and 4
+			modulesMutex.unlock();
 			break;
 
 		default: break;
 	}
 }
 
-bool TransactionsManager::RollbackLedger(std::string newLedger, std::string oldLedger, std::set<std::string> executedTransactions) {
-	std::unordered_set<std::string> toRollback;
+bool TransactionsManager::RollbackLedger(std::string newLedger, std::string oldLedger, const std::vector<Hash160> &executedTransactions, uint64_t ledgerId) {
+	std::unordered_set<Hash160> executed(executedTransactions.begin(), executedTransactions.end());
 	std::vector<std::pair<std::string, uint64_t>> from, to;
 	Transaction *transaction;
 	std::string hash, content, event;
+	Hash160 id, reference;
 	char c;
 	std::vector<char> buffer;
 	buffer.resize(STANDARD_HASH_LENGTH);
 	int count, errorCode;
 	bool outside;
 
-	auto it = executedTransactions.end();
+	auto it = executed.end();
 
 	//open correct ledger
 	std::fstream data(newLedger, std::fstream::in);
 	if(!data.good()) return false;
 
+	//Take the whole incorrect ledger out of the balances if its boundary is still checkpointed,
+	//otherwise each of its differences is reverted
+	std::lock_guard<std::mutex> lock(executionMutex);
+	bool RESTORED = balancesDB->RestoreCheckpoint(ledgerId);
+
 	//forward to transactions
 	data.seekg(LEDGER_SKIP_METADATA, std::ios_base::cur);
 	while(c != ']') data.get(c);
@@ -553,16 +847,53 @@ bool TransactionsManager::RollbackLedger(std::string newLedger, std::string oldL
 		//get hash
 		data.read(&buffer.front(), TRANSACTION_HASH_LENGTH);
 		hash = Util::array_to_string(buffer, TRANSACTION_HASH_LENGTH, 0);
+		if(!Hash160::FromHex(hash, id)) return false; //its hashes were checked against its Merkle root
 		data.seekg(3, std::ios_base::cur);
 		count = 1;
 		outside = true;
 
-		it = executedTransactions.find(hash);
+		it = executed.find(id);
+
+		//transaction correctly registered, its movements are applied again after a restore
+		if(it != executed.end() && RESTORED) {
+			executed.erase(it);
+
+			//fetch its contents
+			content = '{';
+			while(c != '}' && count > 0) {
+				data.get(c);
+				if(c == '"') outside = !outside;
+				if(outside) {
+					if(c == '{') count++;
+					else if(c == '}') count--;
+				}
+				content += c;
+			}
+
+			transaction = Processing::CreateTransaction(managerDAO, managerDAS, content, errorCode);
+			if(errorCode == VALID) {
+				switch(std::stoul(transaction->GetType(), nullptr, 16)) {
+					case TRANSACTION_DAO:
+						managerDAO->Execute(dynamic_cast<DAOTransaction*>(transaction), from, to);
+						break;
 
-		//transaction correctly registered
-		if(it != executedTransactions.end()) {
+					case TRANSACTION_DAS:
+						managerDAS->Execute(dynamic_cast<DASTransaction*>(transaction), from, to);
+						break;
+
+					default:
+						transaction->Execute(from, to);
+				}
+				balancesDB->RollbackBalances(from, to, true);
+
+				from.clear();
+				to.clear();
+				delete transaction;
+			}
+		}
+		else if(it != executed.end()) {
 			//remove from list and skip its content
-			executedTransactions.erase(hash);
+			executed.erase(it);
 			while(c != '}' && count > 0) {
 				data.get(c);
 				if(c == '"') outside = !outside;
@@ -589,6 +920,8 @@ bool TransactionsManager::RollbackLedger(std::string newLedger, std::string oldL
 			//load the transaction
 			transaction = Processing::CreateTransaction(managerDAO, managerDAS, content, errorCode);
 			if(errorCode == VALID) {
+				TransactionsShardStruct &shard = Shard(id);
+
 				//Publish it
 				publisher->PublishTransaction("{\""+hash+"\",:"+transaction->GetTransaction()+"}");
 
@@ -604,13 +937,19 @@ bool TransactionsManager::RollbackLedger(std::string newLedger, std::string oldL
 						event = dynamic_cast<DelayedTransaction*>(transaction)->GetEvent();
 
 						if(event == TX_DELAYED_REQUEST) {
-							delayedTransactions.insert(hash);
-							currentTransactions[hash] = transaction;
+							std::lock_guard<std::mutex> lock(shard.shardMutex);
+							shard.delayedTransactions.insert(id);
+							timers.Schedule(id, TIMER_DELAYED_EXPIRATION, dynamic_cast<RequestDelayedTransaction*>(transaction)->GetExecution() + TRANSACTION_DELAY_NEW);
+							shard.currentTransactions[id] = transaction;
+							Hold(shard, id, HOLD_DELAYED);
 							keep = true;
 						}
-						else if(event == TX_DELAYED_RELEASE) {
-							delayedTransactions.erase(hash);
-							currentTransactions.erase(hash);
+						else if(event == TX_DELAYED_RELEASE && Hash160::FromHex(dynamic_cast<ReleaseDelayedTransaction*>(transaction)->GetRequest().ToString(), reference)) {
+							TransactionsShardStruct &requestShard = Shard(reference);
+							std::lock_guard<std::mutex> lock(requestShard.shardMutex);
+							requestShard.delayedTransactions.erase(reference);
+							timers.Cancel(reference, TIMER_DELAYED_EXPIRATION);
+							Release(requestShard, reference, HOLD_DELAYED);
 						}
 						break;
 
@@ -619,31 +958,38 @@ bool TransactionsManager::RollbackLedger(std::string newLedger, std::string oldL
 						event = dynamic_cast<FutureTransaction*>(transaction)->GetEvent();
 
 						if(event == TX_FUTURE_AUTHORIZE) {
-							futureTransactions[hash] = dynamic_cast<AuthorizeFutureTransaction*>(transaction)->GetValidity();
-							currentTransactions[hash] = transaction;
+							std::lock_guard<std::mutex> lock(shard.shardMutex);
+							shard.futureTransactions[id] = dynamic_cast<AuthorizeFutureTransaction*>(transaction)->GetValidity();
+							timers.Schedule(id, TIMER_FUTURE_EXPIRATION, shard.futureTransactions[id] + TRANSACTION_DELAY_NEW);
+							shard.currentTransactions[id] = transaction;
+							Hold(shard, id, HOLD_FUTURE);
 							keep = true;
 						}
-						else if(event == TX_FUTURE_EXECUTE) {
-							futureTransactions.erase(hash);
-							currentTransactions.erase(hash);
+						else if(event == TX_FUTURE_EXECUTE && Hash160::FromHex(dynamic_cast<ExecuteFutureTransaction*>(transaction)->GetFuture().ToString(), reference)) {
+							TransactionsShardStruct &futureShard = Shard(reference);
+							std::lock_guard<std::mutex> lock(futureShard.shardMutex);
+							futureShard.futureTransactions.erase(reference);
+							timers.Cancel(reference, TIMER_FUTURE_EXPIRATION);
+							Release(futureShard, reference, HOLD_FUTURE);
 						}
 						break;
 
 					case TRANSACTION_DAO:
 						managerDAO->Execute(dynamic_cast<DAOTransaction*>(transaction), from, to);
+						modulesMutex.lock();
 						managerDAO->Register(dynamic_cast<DAOTransaction*>(transaction));
+						modulesMutex.unlock();
 						break;
 
 					case TRANSACTION_DAS:
 						managerDAS->Execute(dynamic_cast<DASTransaction*>(transaction), from, to);
+						modulesMutex.lock();
 						managerDAS->Register(dynamic_cast<DASTransaction*>(transaction));
+						modulesMutex.unlock();
 						break;
 
 					default: break;
 				}
-				//If the transaction is not required, delete it
-				if(!keep && !managerDAO->Enroll(transaction) && !managerDAS->Enroll(transaction)) delete transaction;
-
 				//Register monetary movements
 				ledger->RegisterMovements(transaction->GetTimestamp(), from, to);
 				//Update balances
@@ -651,6 +997,14 @@ bool TransactionsManager::RollbackLedger(std::string newLedger, std::string oldL
 
 				from.clear();
 				to.clear();
+
+				//If the transaction is not required, delete it
+				bool enrolled = false;
+				if(!keep) {
+					std::lock_guard<std::mutex> lock(shard.shardMutex);
+					enrolled = EnrollTransaction(shard, id, transaction);
+				}
+				if(!keep && !enrolled) delete transaction;
 			}
 		}
 		//read separation comma or transactions array's end bracket
@@ -675,15 +1029,16 @@ bool TransactionsManager::RollbackLedger(std::string newLedger, std::string oldL
 		//get hash
 		data.read(&buffer.front(), TRANSACTION_HASH_LENGTH);
 		hash = Util::array_to_string(buffer, TRANSACTION_HASH_LENGTH, 0);
+		if(!Hash160::FromHex(hash, id)) return false; //its hashes were checked against its Merkle root
 		data.seekg(3, std::ios_base::cur);
 		count = 1;
 
-		it = executedTransactions.find(hash);
+		it = executed.find(id);
 
 		//transaction incorrectly registered
-		if(it != executedTransactions.end()) {
+		if(it != executed.end()) {
 			//remove from list
-			executedTransactions.erase(hash);
+			executed.erase(it);
 
 			//fetch its contents
 			content = '{';
@@ -699,7 +1054,7 @@ bool TransactionsManager::RollbackLedger(std::string newLedger, std::string oldL
 
 			//load the transaction and rollback it
 			transaction = Processing::CreateTransaction(managerDAO, managerDAS, content, errorCode);
-			if(errorCode == VALID) RollbackTransaction(transaction);
+			if(errorCode == VALID) RollbackTransaction(transaction, !RESTORED);
 			delete transaction;
 		}
 		//otherwise skip it
@@ -717,12 +1072,16 @@ bool TransactionsManager::RollbackLedger(std::string newLedger, std::string oldL
 	}
 
 	data.close();
+
+	//Persist the restored balances along with the journals' position they now reflect
+	if(RESTORED) balancesDB->Flush(std::bind(&Ledger::JournalPosition, ledger));
 	return true;
 }
 
 bool TransactionsManager::RegisterLedger(std::string ledgerFile) {
 	Transaction *transaction;
 	std::string hash, content, event;
+	Hash160 id, reference;
 	char c;
 	std::vector<char> buffer;
 	buffer.resize(STANDARD_HASH_LENGTH);
@@ -745,6 +1104,7 @@ bool TransactionsManager::RegisterLedger(std::string ledgerFile) {
 		//get hash
 		data.read(&buffer.front(), TRANSACTION_HASH_LENGTH);
 		hash = Util::array_to_string(buffer, TRANSACTION_HASH_LENGTH, 0);
+		if(!Hash160::FromHex(hash, id)) return false; //its hashes were checked against its Merkle root
 		data.seekg(3, std::ios_base::cur);
 		count = 1;
 		outside = true;
@@ -764,6 +1124,8 @@ bool TransactionsManager::RegisterLedger(std::string ledgerFile) {
 		//load the transaction
 		transaction = Processing::CreateTransaction(managerDAO, managerDAS, content, errorCode);
 		if(errorCode == VALID) {
+			TransactionsShardStruct &shard = Shard(id);
+
 			//Publish it
 			publisher->PublishTransaction("{\""+hash+"\",:"+transaction->GetTransaction()+"}");
 
@@ -775,41 +1137,62 @@ bool TransactionsManager::RegisterLedger(std::string ledgerFile) {
 				case TRANSACTION_DELAYED:
 					event = dynamic_cast<DelayedTransaction*>(transaction)->GetEvent();
 					if(event == TX_DELAYED_REQUEST) {
-						delayedTransactions.insert(hash);
-						currentTransactions[hash] = transaction;
+						std::lock_guard<std::mutex> lock(shard.shardMutex);
+						shard.delayedTransactions.insert(id);
+						timers.Schedule(id, TIMER_DELAYED_EXPIRATION, dynamic_cast<RequestDelayedTransaction*>(transaction)->GetExecution() + TRANSACTION_DELAY_NEW);
+						shard.currentTransactions[id] = transaction;
+						Hold(shard, id, HOLD_DELAYED);
 						keep = true;
 					}
-					else if(event == TX_DELAYED_RELEASE) {
-						delayedTransactions.erase(hash);
-						currentTransactions.erase(hash);
+					else if(event == TX_DELAYED_RELEASE && Hash160::FromHex(dynamic_cast<ReleaseDelayedTransaction*>(transaction)->GetRequest().ToString(), reference)) {
+						TransactionsShardStruct &requestShard = Shard(reference);
+						std::lock_guard<std::mutex> lock(requestShard.shardMutex);
+						requestShard.delayedTransactions.erase(reference);
+						timers.Cancel(reference, TIMER_DELAYED_EXPIRATION);
+						Release(requestShard, reference, HOLD_DELAYED);
 					}
 					break;
 
 				case TRANSACTION_FUTURE:
 					event = dynamic_cast<FutureTransaction*>(transaction)->GetEvent();
 					if(event == TX_FUTURE_AUTHORIZE) {
-						futureTransactions[hash] = dynamic_cast<RequestDelayedTransaction*>(transaction)->GetExecution();
-						currentTransactions[hash] = transaction;
+						std::lock_guard<std::mutex> lock(shard.shardMutex);
+						shard.futureTransactions[id] = dynamic_cast<AuthorizeFutureTransaction*>(transaction)->GetValidity();
+						timers.Schedule(id, TIMER_FUTURE_EXPIRATION, shard.futureTransactions[id] + TRANSACTION_DELAY_NEW);
+						shard.currentTransactions[id] = transaction;
+						Hold(shard, id, HOLD_FUTURE);
 						keep = true;
 					}
-					else if(event == TX_FUTURE_EXECUTE) {
-						futureTransactions.erase(hash);
-						currentTransactions.erase(hash);
+					else if(event == TX_FUTURE_EXECUTE && Hash160::FromHex(dynamic_cast<ExecuteFutureTransaction*>(transaction)->GetFuture().ToString(), reference)) {
+						TransactionsShardStruct &futureShard = Shard(reference);
+						std::lock_guard<std::mutex> lock(futureShard.shardMutex);
+						futureShard.futureTransactions.erase(reference);
+						timers.Cancel(reference, TIMER_FUTURE_EXPIRATION);
+						Release(futureShard, reference, HOLD_FUTURE);
 					}
 					break;
 
 				case TRANSACTION_DAO:
+					modulesMutex.lock();
 					managerDAO->Register(dynamic_cast<DAOTransaction*>(transaction));
+					modulesMutex.unlock();
 					break;
 
 				case TRANSACTION_DAS:
+					modulesMutex.lock();
 					managerDAS->Register(dynamic_cast<DASTransaction*>(transaction));
+					modulesMutex.unlock();
 					break;
 
 				default:  break;
 			}
 			//If the transaction is not required, delete it
-			if(!keep && !managerDAO->Enroll(transaction) && !managerDAS->Enroll(transaction)) delete transaction;
+			bool enrolled = false;
+			if(!keep) {
+				std::lock_guard<std::mutex> lock(shard.shardMutex);
+				enrolled = EnrollTransaction(shard, id, transaction);
+			}
+			if(!keep && !enrolled) delete transaction;
 		}
 		//read separation comma or transactions array's end bracket
 		data.get(c);
@@ -820,10 +1203,13 @@ bool TransactionsManager::RegisterLedger(std::string ledgerFile) {
 }
 
 bool TransactionsManager::GetTransaction(std::string hash, std::string &transactionOut) {
-	std::lock_guard<std::mutex> lock(dataMutex);
+	Hash160 id;
+	if(!Hash160::FromHex(hash, id)) return false;
+	TransactionsShardStruct &shard = Shard(id);
+	std::lock_guard<std::mutex> lock(shard.shardMutex);
 	
-	auto it = currentTransactions.find(hash);
-	if(it != currentTransactions.end()) {
+	auto it = shard.currentTransactions.find(id);
+	if(it != shard.currentTransactions.end()) {
 		transactionOut = it->second->GetTransaction();
 		return true;
 	}
@@ -831,10 +1217,13 @@ bool TransactionsManager::GetTransaction(std::string hash, std::string &transact
 }
 
 bool TransactionsManager::GetTransaction(std::string hash, Transaction *&transactionPtr) {
-	std::lock_guard<std::mutex> lock(dataMutex);
+	Hash160 id;
+	if(!Hash160::FromHex(hash, id)) return false;
+	TransactionsShardStruct &shard = Shard(id);
+	std::lock_guard<std::mutex> lock(shard.shardMutex);
 	
-	auto it = currentTransactions.find(hash);
-	if(it != currentTransactions.end()) {
+	auto it = shard.currentTransactions.find(id);
+	if(it != shard.currentTransactions.end()) {
 		transactionPtr = it->second;
 		return true;
 	}
@@ -842,11 +1231,17 @@ bool TransactionsManager::GetTransaction(std::string hash, Transaction *&transac
 }
 
 bool TransactionsManager::FindRequest(std::string hash, RequestDelayedTransaction *&transaction, int &errorCode) {	
-	std::lock_guard<std::mutex> lock(dataMutex);
+	Hash160 id;
+	if(!Hash160::FromHex(hash, id)) {
+		errorCode = ERROR_HASH;
+		return false;
+	}
+	TransactionsShardStruct &shard = Shard(id);
+	std::lock_guard<std::mutex> lock(shard.shardMutex);
 	
-	auto it = delayedTransactions.find(hash);
-	if(it != delayedTransactions.end()) {
-		transaction = dynamic_cast<RequestDelayedTransaction*>(currentTransactions[*it]);
+	auto it = shard.delayedTransactions.find(id);
+	if(it != shard.delayedTransactions.end()) {
+		transaction = dynamic_cast<RequestDelayedTransaction*>(shard.currentTransactions[*it]);
 		return true;
 	}
 	errorCode = ERROR_HASH;
@@ -854,22 +1249,28 @@ bool TransactionsManager::FindRequest(std::string hash, RequestDelayedTransactio
 }
 
 bool TransactionsManager::FindAuthorize(std::string hash, AuthorizeFutureTransaction *&transaction, int &errorCode) {
-	std::lock_guard<std::mutex> lock(dataMutex);
+	Hash160 id;
+	if(!Hash160::FromHex(hash, id)) {
+		errorCode = ERROR_HASH;
+		return false;
+	}
+	TransactionsShardStruct &shard = Shard(id);
+	std::lock_guard<std::mutex> lock(shard.shardMutex);
 	
-	auto it = futureTransactions.find(hash);
-	if(it != futureTransactions.end()) {
+	auto it = shard.futureTransactions.find(id);
+	if(it != shard.futureTransactions.end()) {
 		auto now = Util::current_timestamp_nanos();
 
 		//Verify its validity
-		if((it->second + TRANSACTION_DELAY_NEW) < now) {
-			transaction = dynamic_cast<AuthorizeFutureTransaction*>(currentTransactions[hash]);
+		if(now <= (it->second + TRANSACTION_DELAY_NEW)) {
+			transaction = dynamic_cast<AuthorizeFutureTransaction*>(shard.currentTransactions[id]);
 			return true;
 		}
 		else {
 			//delete if it expired
-			futureTransactions.erase(hash);
-			delete currentTransactions[hash];
-			currentTransactions.erase(hash);
+			shard.futureTransactions.erase(it);
+			timers.Cancel(id, TIMER_FUTURE_EXPIRATION);
+			Release(shard, id, HOLD_FUTURE);
 
 			errorCode = ERROR_TIMESTAMP;
 		}
@@ -877,4 +1278,12 @@ bool TransactionsManager::FindAuthorize(std::string hash, AuthorizeFutureTransac
 	else errorCode = ERROR_HASH;
 
 	return false;
+}
+
+uint64_t TransactionsManager::QueueDepth() {
+	return processingQueue.Depth();
+}
+
+uint64_t TransactionsManager::QueueHighWaterMark() {
+	return processingQueue.HighWaterMark();
 }
\ No newline at end of file
@@ -39,9 +39,6 @@
 #define TRANSACTIONS_MANAGER_H
 
 #include <mutex>
-#include <queue>
-#include <list>
-#include <set>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -49,7 +46,12 @@
 #include <utility>
 #include <vector>
 
+#include "admission_control.h"
 #include "globals.h"
+#include "hash160.h"
+#include "seen_filter.h"
+#include "timer_wheel.h"
+#include "transactions_queue.h"
 
 class AuthorizeFutureTransaction;
 class Balances;
@@ -63,6 +65,29 @@ class Publisher;
 class RequestDelayedTransaction;
 class Transaction;
 
+struct ExecutionStruct;
+
+
+//Mempool state of the transactions whose hash falls into it, guarded by its own lock
+struct TransactionsShardStruct {
+	std::mutex shardMutex;
+
+	std::unordered_map<Hash160, Transaction*> currentTransactions;
+	std::unordered_set<Hash160> rejectionList;
+
+	std::unordered_map<Hash160, int> missingList;
+	std::unordered_map<Hash160, std::string> submissionList;
+	std::unordered_map<Hash160, std::pair<int,std::vector<std::string>>> confirmationList;
+
+	std::unordered_set<Hash160> delayedTransactions;
+	std::unordered_map<Hash160, uint64_t> futureTransactions;
+	std::unordered_set<Hash160> moduleTransactions;
+	std::unordered_set<Hash160> rolledBack; //rolled back while still queued or verified, processing lets them go
+
+	//Ownership of currentTransactions, freed once nothing holds them
+	std::unordered_map<Hash160, uint> holds;
+	std::vector<Transaction*> retiredTransactions;
+};
 
 class TransactionsManager {
 	public:
@@ -72,12 +97,16 @@ class TransactionsManager {
 		void ProcessTransactions(bool *IS_OPERATING, Balances *balancesDB, DAOManager *managerDAO, DASManager *managerDAS, Entities *entities, Ledger *ledger, ModulesInterface *interface, Nodes *nodes);
 		void TransactionsRegistration(bool *IS_OPERATING);
 
+		bool AdmitSubmission(std::string entityId, int &errorCode);
+		void CancelSubmission(std::string entityId);
+		bool IsKnown(const Hash160 &hash);
 		bool AddTransaction(Transaction *transaction, int &errorCode, bool process=false, uint dispatcher=DISPATCHER_NODE, std::string dispatcherId="");
 		void FailedToFetch(std::string hash);
 		void AddConfirmation(std::string hash, std::string node);
+		void AddConfirmation(const Hash160 &id, std::string node);
 
-		void RollbackTransaction(Transaction *transaction);
-		bool RollbackLedger(std::string newLedger, std::string oldLedger, std::set<std::string> executedTransactions);
+		void RollbackTransaction(Transaction *transaction, bool revertBalances=true);
+		bool RollbackLedger(std::string newLedger, std::string oldLedger, const std::vector<Hash160> &executedTransactions, uint64_t ledgerId);
 		bool RegisterLedger(std::string ledgerFile);
 
 		bool GetTransaction(std::string hash, std::string &transactionOut);
@@ -85,29 +114,42 @@ class TransactionsManager {
 		bool FindRequest(std::string hash, RequestDelayedTransaction *&transaction, int &errorCode);
 		bool FindAuthorize(std::string hash, AuthorizeFutureTransaction *&transaction, int &errorCode);
 
+		uint64_t QueueDepth();
+		uint64_t QueueHighWaterMark();
+
 	private:
-		std::mutex dataMutex;
+		std::mutex modulesMutex; //DAO and DAS managers are not thread safe
+		std::mutex executionMutex; //held until executed movements are journaled
 		Balances *balancesDB;
 		DAOManager *managerDAO;
 		DASManager *managerDAS;
 		Ledger *ledger;
+		ModulesInterface *interface;
 		Nodes *nodes;
 		Publisher *publisher;
 
-		std::unordered_map<std::string, Transaction*> currentTransactions;
-		std::unordered_set<std::string> rejectionList;
+		TransactionsShardStruct shards[TRANSACTIONS_SHARDS];
+		TransactionsQueue processingQueue;
+		AdmissionControl admission; //managing entities' submissions budgets
+		SeenFilter seen; //transactions recently added or rejected
+		TimerWheel timers; //registrations and expirations
 
-		std::unordered_map<std::string, int> missingList;
-		std::unordered_map<std::string, std::string> submissionList;
-		std::queue<std::string> processingQueue;
+		TransactionsShardStruct& Shard(const Hash160 &hash);
+		Transaction* Lookup(const Hash160 &hash);
+		//Same as above for the processing thread, which retires the transactions rolled back meanwhile
+		Transaction* Claim(const Hash160 &hash);
 
-		std::unordered_map<std::string, std::pair<int,std::vector<std::string>>> confirmationList;
-		std::list<std::pair<uint64_t,std::string>> registrationList;
+		void ExecuteTransaction(ExecutionStruct &execution);
+		void ExpireTransaction(TimerStruct &timer);
 
-		std::unordered_set<std::string> delayedTransactions;
-		std::unordered_map<std::string, uint64_t> futureTransactions;
+		//The shard's lock must be held by the caller
+		bool IsConfirmed(TransactionsShardStruct &shard, Hash160 hash);
+		bool EnrollTransaction(TransactionsShardStruct &shard, Hash160 hash, Transaction *transaction);
+		void Hold(TransactionsShardStruct &shard, Hash160 hash, uint reason);
+		void Release(TransactionsShardStruct &shard, Hash160 hash, uint reason);
+		void Retire(TransactionsShardStruct &shard, Hash160 hash);
 
-		bool IsConfirmed(std::string hash);
+		void Reclaim();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,140 @@
+/*
+	Copyright (c) 2016-2017, Unified Digital Currency
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+	WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/**
+ * @file transactions_queue.cpp
+ * @author Rafael Afonso Rodrigues <founder@udc.world>
+ * @date 2016
+ * UDC Validating Node.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "globals.h"
+#include "hash160.h"
+#include "transactions_queue.h"
+
+
+TransactionsQueue::TransactionsQueue(uint capacity /*=TRANSACTION_QUEUE_CAPACITY*/) : enqueuePosition(0), dequeuePosition(0), highWaterMark(0), IS_WAITING(false) {
+	//round capacity up to a power of two so positions can be masked
+	uint64_t size = 2;
+	while(size < capacity) size <<= 1;
+
+	buffer = std::vector<Cell>(size);
+	mask = size - 1;
+	for(uint64_t i = 0; i < size; i++) buffer[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+bool TransactionsQueue::Push(Hash160 hash) {
+	Cell *cell;
+	uint64_t position = enqueuePosition.load(std::memory_order_relaxed);
+
+	//Step 1: claim a free cell
+	while(true) {
+		cell = &buffer[position & mask];
+		uint64_t sequence = cell->sequence.load(std::memory_order_acquire);
+		int64_t difference = (int64_t)sequence - (int64_t)position;
+
+		if(difference == 0) {
+			if(enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+		}
+		//queue is full
+		else if(difference < 0) return false;
+		else position = enqueuePosition.load(std::memory_order_relaxed);
+	}
+
+	//Step 2: publish the hash to the consumer
+	cell->hash = hash;
+	cell->sequence.store(position + 1, std::memory_order_release);
+
+	//Step 3: track the deepest the queue has been
+	uint64_t depth = position + 1 - dequeuePosition.load(std::memory_order_relaxed);
+	uint64_t highest = highWaterMark.load(std::memory_order_relaxed);
+	while(depth > highest && !highWaterMark.compare_exchange_weak(highest, depth, std::memory_order_relaxed));
+
+	//Step 4: only wake the consumer if it is actually parked
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if(IS_WAITING.load(std::memory_order_relaxed)) WakeUp();
+
+	return true;
+}
+
+bool TransactionsQueue::Pop(Hash160 &hash) {
+	uint64_t position = dequeuePosition.load(std::memory_order_relaxed);
+	Cell *cell = &buffer[position & mask];
+
+	//nothing published yet at the head
+	if(cell->sequence.load(std::memory_order_acquire) != position + 1) return false;
+
+	hash = cell->hash;
+
+	//release the cell for the next lap of producers
+	dequeuePosition.store(position + 1, std::memory_order_relaxed);
+	cell->sequence.store(position + mask + 1, std::memory_order_release);
+	return true;
+}
+
+bool TransactionsQueue::Wait(Hash160 &hash, uint timeout /*=TRANSACTION_QUEUE_WAIT*/) {
+	if(Pop(hash)) return true;
+
+	std::unique_lock<std::mutex> lock(waitMutex);
+	IS_WAITING.store(true, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	//re-check after announcing we are parked so a concurrent push is never missed
+	bool popped = Pop(hash);
+	if(!popped) {
+		waitCondition.wait_for(lock, std::chrono::milliseconds(timeout));
+		popped = Pop(hash);
+	}
+
+	IS_WAITING.store(false, std::memory_order_relaxed);
+	return popped;
+}
+
+void TransactionsQueue::WakeUp() {
+	std::lock_guard<std::mutex> lock(waitMutex);
+	waitCondition.notify_one();
+}
+
+uint64_t TransactionsQueue::Depth() {
+	uint64_t dequeued = dequeuePosition.load(std::memory_order_relaxed);
+	uint64_t enqueued = enqueuePosition.load(std::memory_order_relaxed);
+	return enqueued > dequeued ? enqueued - dequeued : 0;
+}
+
+uint64_t TransactionsQueue::HighWaterMark() {
+	return highWaterMark.load(std::memory_order_relaxed);
+}
\ No newline at end of file
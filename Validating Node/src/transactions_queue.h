@@ -0,0 +1,85 @@
+/*
+	Copyright (c) 2016-2017, Unified Digital Currency
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+	WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/**
+ * @file transactions_queue.h
+ * @author Rafael Afonso Rodrigues <founder@udc.world>
+ * @date 2016
+ * UDC Validating Node.
+ */
+
+#ifndef TRANSACTIONS_QUEUE_H
+#define TRANSACTIONS_QUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "globals.h"
+#include "hash160.h"
+
+
+//Bounded lock-free queue with multiple producers (listening threads) and a single consumer (processing thread)
+class TransactionsQueue {
+	public:
+		TransactionsQueue(uint capacity=TRANSACTION_QUEUE_CAPACITY);
+		~TransactionsQueue(){}
+
+		bool Push(Hash160 hash);
+		bool Pop(Hash160 &hash);
+		bool Wait(Hash160 &hash, uint timeout=TRANSACTION_QUEUE_WAIT);
+		void WakeUp();
+
+		uint64_t Depth();
+		uint64_t HighWaterMark();
+
+	private:
+		struct Cell {
+			std::atomic<uint64_t> sequence;
+			Hash160 hash;
+		};
+
+		std::vector<Cell> buffer;
+		uint64_t mask;
+
+		//keep producers' and consumer's positions on separate cache lines
+		alignas(64) std::atomic<uint64_t> enqueuePosition;
+		alignas(64) std::atomic<uint64_t> dequeuePosition;
+		alignas(64) std::atomic<uint64_t> highWaterMark;
+
+		//wakeup of the consumer, only touched by producers while it is parked
+		std::atomic<bool> IS_WAITING;
+		std::mutex waitMutex;
+		std::condition_variable waitCondition;
+};
+
+#endif
\ No newline at end of file
@@ -100,11 +100,15 @@ std::string Util::string_to_base64(std::string input) {
 
 
 std::string Util::base64_to_string(std::string input) {
+	return base64_to_string(input.data(), input.size());
+}
+
+std::string Util::base64_to_string(const char *input, size_t length) {
 	std::string output;
-    std::vector<unsigned char> bytes(input.begin(), input.end());
 
+	//decoded straight from the caller's bytes
 	CryptoPP::Base64Decoder decoder;
-	decoder.Put((byte*) bytes.data(), bytes.size());
+	decoder.Put((const byte*) input, length);
 	decoder.MessageEnd();
 
 	CryptoPP::word64 size = decoder.MaxRetrievable();
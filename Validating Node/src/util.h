@@ -54,6 +54,7 @@ namespace Util {
 
 	std::string string_to_base64(std::string input);
 	std::string base64_to_string(std::string input);
+	std::string base64_to_string(const char *input, size_t length);
 
 	void string_to_array(std::string input, std::vector<char> &output);
 	void string_to_array(std::string input, uint size, uint offset, std::vector<char> &output);
@@ -0,0 +1,127 @@
+/*
+	Copyright (c) 2016-2017, Unified Digital Currency
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+	WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/**
+ * @file verification_pool.cpp
+ * @author Rafael Afonso Rodrigues <founder@udc.world>
+ * @date 2016
+ * UDC Validating Node.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "codes.h"
+#include "globals.h"
+#include "hash160.h"
+#include "modules_interface.h"
+#include "transaction.h"
+#include "verification_pool.h"
+
+
+VerificationPool::VerificationPool(ModulesInterface *interface, uint workers /*=0*/) : interface(interface) {
+	//by default leave one core for the processing thread
+	if(!workers) {
+		workers = std::thread::hardware_concurrency();
+		if(workers > 1) workers--;
+		else workers = 1;
+	}
+
+	for(uint i = 0; i < workers; i++) this->workers.push_back(std::thread(&VerificationPool::Work, this));
+}
+
+VerificationPool::~VerificationPool() {
+	jobsMutex.lock();
+	IS_OPERATING = false;
+	jobsMutex.unlock();
+	jobsCondition.notify_all();
+
+	for(auto it = workers.begin(); it != workers.end(); ++it) it->join();
+}
+
+void VerificationPool::Submit(Hash160 hash, Transaction *transaction) {
+	jobsMutex.lock();
+	jobs.push({submitted++, hash, transaction});
+	jobsMutex.unlock();
+	jobsCondition.notify_one();
+}
+
+bool VerificationPool::Next(Hash160 &hash, int &errorCode, uint timeout /*=TRANSACTION_QUEUE_WAIT*/) {
+	if(submitted == delivered) return false;
+
+	std::unique_lock<std::mutex> lock(resultsMutex);
+
+	//wait for the oldest submitted transaction, even if newer ones are already verified
+	auto it = results.find(delivered);
+	if(it == results.end()) {
+		resultsCondition.wait_for(lock, std::chrono::milliseconds(timeout), [this]{ return results.find(delivered) != results.end(); });
+		it = results.find(delivered);
+		if(it == results.end()) return false;
+	}
+
+	hash = it->second.first;
+	errorCode = it->second.second;
+	results.erase(it);
+	delivered++;
+	return true;
+}
+
+uint64_t VerificationPool::Pending() {
+	return submitted - delivered;
+}
+
+void VerificationPool::Work() {
+	Job job;
+	int errorCode;
+
+	while(true) {
+		std::unique_lock<std::mutex> lock(jobsMutex);
+		jobsCondition.wait(lock, [this]{ return !jobs.empty() || !IS_OPERATING; });
+		if(!IS_OPERATING) return;
+
+		job = jobs.front();
+		jobs.pop();
+		lock.unlock();
+
+		//amounts, accounts and signatures, no balances or ledger state is touched
+		errorCode = VALID;
+		job.transaction->Verify(interface, errorCode);
+
+		resultsMutex.lock();
+		results[job.sequence] = std::make_pair(job.hash, errorCode);
+		resultsMutex.unlock();
+		resultsCondition.notify_one();
+	}
+}
\ No newline at end of file
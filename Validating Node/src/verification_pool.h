@@ -0,0 +1,93 @@
+/*
+	Copyright (c) 2016-2017, Unified Digital Currency
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+	WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/**
+ * @file verification_pool.h
+ * @author Rafael Afonso Rodrigues <founder@udc.world>
+ * @date 2016
+ * UDC Validating Node.
+ */
+
+#ifndef VERIFICATION_POOL_H
+#define VERIFICATION_POOL_H
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "globals.h"
+#include "hash160.h"
+
+class ModulesInterface;
+class Transaction;
+
+
+//Runs the stateless checks of transactions in parallel and returns them in their arrival order
+class VerificationPool {
+	public:
+		VerificationPool(ModulesInterface *interface, uint workers=0);
+		~VerificationPool();
+
+		void Submit(Hash160 hash, Transaction *transaction);
+		bool Next(Hash160 &hash, int &errorCode, uint timeout=TRANSACTION_QUEUE_WAIT);
+		uint64_t Pending();
+
+	private:
+		struct Job {
+			uint64_t sequence;
+			Hash160 hash;
+			Transaction *transaction;
+		};
+
+		ModulesInterface *interface;
+		bool IS_OPERATING = true;
+		std::vector<std::thread> workers;
+
+		std::mutex jobsMutex;
+		std::condition_variable jobsCondition;
+		std::queue<Job> jobs;
+
+		std::mutex resultsMutex;
+		std::condition_variable resultsCondition;
+		std::unordered_map<uint64_t, std::pair<Hash160,int>> results;
+
+		//only used by the submitting thread
+		uint64_t submitted = 0;
+		uint64_t delivered = 0;
+
+		void Work();
+};
+
+#endif
\ No newline at end of file
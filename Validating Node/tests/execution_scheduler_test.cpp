@@ -0,0 +1,223 @@
+/*
+	Copyright (c) 2016-2017, Unified Digital Currency
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+	WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/**
+ * @file execution_scheduler_test.cpp
+ * @author Rafael Afonso Rodrigues <founder@udc.world>
+ * @date 2016
+ * UDC Validating Node.
+ *
+ * Checks that executing batches through the ExecutionScheduler leaves the same balances
+ * and results as executing them one by one, both against the node's Balances on RocksDB.
+ * Build it from the src directory, then run it from anywhere (it works in a temporary directory):
+ *   g++ -std=c++11 -pthread -I. ../tests/execution_scheduler_test.cpp execution_scheduler.cpp balances.cpp database.cpp hash160.cpp util.cpp -lrocksdb -lcryptopp -lboost_filesystem -lboost_system -o execution_scheduler_test
+ *   ./execution_scheduler_test
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "includes/boost/filesystem.hpp"
+#include "includes/rocksdb/db.h"
+
+#include "balances.h"
+#include "codes.h"
+#include "database.h"
+#include "execution_scheduler.h"
+#include "globals.h"
+
+#define TEST_ROUNDS			200
+#define TEST_BATCH			512
+#define TEST_ACCOUNTS		24
+#define TEST_BALANCE		1000
+
+//databases tuning, normally read by LoadConfigurations
+unsigned int _DATABASE_CACHE_BUDGET = DEFAULT_DATABASE_CACHE_BUDGET;
+unsigned int _DATABASE_WRITE_BUFFER = DEFAULT_DATABASE_WRITE_BUFFER;
+unsigned int _DATABASE_BLOOM_BITS = DEFAULT_DATABASE_BLOOM_BITS;
+
+
+//A balances store of its own, laid out like the node's: metadata in the default family
+struct TestDatabaseStruct {
+	rocksdb::DB *db = nullptr;
+	std::vector<rocksdb::ColumnFamilyHandle*> families;
+	Balances *balances = nullptr;
+};
+
+bool OpenDatabase(TestDatabaseStruct &database, std::string path) {
+	rocksdb::DBOptions options;
+	options.create_if_missing = true;
+	options.create_missing_column_families = true;
+
+	std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
+	descriptors.push_back(rocksdb::ColumnFamilyDescriptor(rocksdb::kDefaultColumnFamilyName, rocksdb::ColumnFamilyOptions()));
+	descriptors.push_back(rocksdb::ColumnFamilyDescriptor("balances", Database::Profile(DATABASE_PROFILE_BALANCES)));
+
+	rocksdb::Status status = rocksdb::DB::Open(options, path, descriptors, &database.families, &database.db);
+	if(!status.ok()) {
+		std::cout << "unable to open " << path << ": " << status.ToString() << std::endl;
+		return false;
+	}
+	database.balances = new Balances(database.db, database.families[1], database.families[0]);
+	return true;
+}
+
+void CloseDatabase(TestDatabaseStruct &database) {
+	delete database.balances;
+	for(auto family = database.families.begin(); family != database.families.end(); ++family) database.db->DestroyColumnFamilyHandle(*family);
+	delete database.db;
+}
+
+uint64_t StoredBalance(TestDatabaseStruct &database, std::string account) {
+	std::string value;
+	rocksdb::Status status = database.db->Get(rocksdb::ReadOptions(), database.families[1], account, &value);
+	return status.ok() ? Database::DecodeBalance(value) : 0;
+}
+
+//The balances step of TransactionsManager::ExecuteTransaction, verification already happened
+void Execute(Balances &balances, ExecutionStruct &execution) {
+	if(!execution.exclusive) {
+		if(!balances.UpdateBalances(execution.senders, execution.receivers)) execution.errorCode = ERROR_INSUFICIENT_FUNDS;
+		return;
+	}
+
+	//Depends on everything applied before it, like module state does: sweeps half of an account into another
+	std::vector<std::pair<std::string, uint64_t>> from, to;
+	uint64_t amount = balances.GetBalance(execution.senders[0].first) / 2;
+	from.push_back(std::make_pair(execution.senders[0].first, amount));
+	to.push_back(std::make_pair(execution.receivers[0].first, amount));
+	if(!balances.UpdateBalances(from, to)) execution.errorCode = ERROR_INSUFICIENT_FUNDS;
+}
+
+std::string Account(std::mt19937 &random, uint round) {
+	return "r" + std::to_string(round) + "account" + std::to_string(random() % TEST_ACCOUNTS);
+}
+
+std::vector<ExecutionStruct> GenerateBatch(std::mt19937 &random, uint round) {
+	std::vector<ExecutionStruct> batch(TEST_BATCH);
+
+	for(auto execution = batch.begin(); execution != batch.end(); ++execution) {
+		execution->transaction = nullptr;
+		execution->type = TRANSACTION_BASIC;
+		execution->exclusive = random() % 64 == 0;
+
+		//some fail verification and must be skipped
+		execution->errorCode = random() % 32 == 0 ? ERROR_TRANSACTION_INVALID : VALID;
+
+		if(execution->exclusive) {
+			execution->type = TRANSACTION_DAO;
+			execution->senders.push_back(std::make_pair(Account(random, round), 0));
+			execution->receivers.push_back(std::make_pair(Account(random, round), 0));
+			continue;
+		}
+
+		//Balanced movements, amounts large enough for some to overdraw, the world bank is never short of funds
+		uint64_t total = 0;
+		uint senders = 1 + random() % 3, receivers = 1 + random() % 3;
+		for(uint i = 0; i < senders; i++) {
+			bool issued = random() % 16 == 0;
+			uint64_t amount = 1 + random() % (issued ? TEST_BALANCE * 4 : TEST_BALANCE / 2);
+			execution->senders.push_back(std::make_pair(issued ? WORLD_BANK_ACCOUNT : Account(random, round), amount));
+			total += amount;
+		}
+		for(uint i = 1; i < receivers; i++) {
+			uint64_t amount = random() % (total + 1);
+			execution->receivers.push_back(std::make_pair(Account(random, round), amount));
+			total -= amount;
+		}
+		execution->receivers.push_back(std::make_pair(Account(random, round), total));
+	}
+	return batch;
+}
+
+int main() {
+	std::mt19937 random(2017);
+	uint failures = 0;
+
+	boost::filesystem::path directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("execution_scheduler_test_%%%%%%%%");
+	boost::filesystem::create_directories(directory);
+
+	TestDatabaseStruct serial, parallel;
+	if(!OpenDatabase(serial, (directory / "serial").string()) || !OpenDatabase(parallel, (directory / "parallel").string())) {
+		boost::filesystem::remove_all(directory);
+		return EXIT_FAILURE;
+	}
+
+	for(uint round = 0; round < TEST_ROUNDS; round++) {
+		//every round starts from fresh accounts, the world bank carries over
+		std::unordered_map<std::string, uint64_t> initial;
+		for(uint i = 0; i < TEST_ACCOUNTS; i++) initial["r" + std::to_string(round) + "account" + std::to_string(i)] = TEST_BALANCE;
+		serial.balances->UpdateFromLedger(initial);
+		parallel.balances->UpdateFromLedger(initial);
+
+		std::vector<ExecutionStruct> expected = GenerateBatch(random, round);
+		std::vector<ExecutionStruct> batch = expected;
+
+		//the current serial path, one transaction at a time in submission order
+		for(auto execution = expected.begin(); execution != expected.end(); ++execution) {
+			if(execution->errorCode == VALID) Execute(*serial.balances, *execution);
+		}
+
+		ExecutionScheduler scheduler([&parallel](ExecutionStruct &execution) { Execute(*parallel.balances, execution); }, 1 + round % 8);
+		scheduler.Execute(batch);
+
+		bool matches = true;
+		for(size_t i = 0; i < batch.size() && matches; i++) matches = batch[i].errorCode == expected[i].errorCode;
+
+		//Same balances, both cached and once merged into the database
+		std::vector<std::string> accounts(1, WORLD_BANK_ACCOUNT);
+		for(auto it = initial.begin(); it != initial.end(); ++it) accounts.push_back(it->first);
+		for(auto account = accounts.begin(); account != accounts.end() && matches; ++account) matches = serial.balances->GetBalance(*account) == parallel.balances->GetBalance(*account);
+
+		serial.balances->Flush([]() { return std::string(); });
+		parallel.balances->Flush([]() { return std::string(); });
+		for(auto account = accounts.begin(); account != accounts.end() && matches; ++account) matches = StoredBalance(serial, *account) == StoredBalance(parallel, *account);
+
+		if(!matches) {
+			std::cout << "round " << round << ": parallel execution differs from serial execution" << std::endl;
+			failures++;
+		}
+	}
+
+	CloseDatabase(serial);
+	CloseDatabase(parallel);
+	boost::filesystem::remove_all(directory);
+
+	if(failures) return EXIT_FAILURE;
+	std::cout << "execution scheduler: " << TEST_ROUNDS << " batches match serial execution" << std::endl;
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,131 @@
+/*
+	Copyright (c) 2016-2017, Unified Digital Currency
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+	WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/**
+ * @file transaction_arena_benchmark.cpp
+ * @author Rafael Afonso Rodrigues <founder@udc.world>
+ * @date 2016
+ * UDC Validating Node.
+ *
+ * Counts the heap allocations the transaction path makes, from the received form to a transaction
+ * ready to be relayed, appended and published: Processing::CreateTransaction parses it, orders its
+ * data and hashes it, then a share is detached like requests and authorizations are. Every malloc
+ * is counted, so it needs glibc. Build it twice from the src directory, against every source but
+ * main.cpp; the second build gives each transaction an arena of its own, allocating like the
+ * documents with their own allocators transactions used to have:
+ *   g++ -std=c++11 -O2 -pthread -I. ../tests/transaction_arena_benchmark.cpp $(ls *.cpp | grep -v main.cpp) -lrocksdb -lcryptopp -lboost_filesystem -lboost_regex -lboost_system -o transaction_arena_benchmark
+ *   g++ -std=c++11 -O2 -pthread -I. -DTRANSACTION_ARENA_SIZE=0 ../tests/transaction_arena_benchmark.cpp $(ls *.cpp | grep -v main.cpp) -lrocksdb -lcryptopp -lboost_filesystem -lboost_regex -lboost_system -o transaction_arena_benchmark_own
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "codes.h"
+#include "globals.h"
+#include "processing.h"
+#include "transaction.h"
+
+#define BENCHMARK_TRANSACTIONS		20000
+#define BENCHMARK_DETACHED			16 //one in every, kept around like a delayed request
+
+extern "C" {
+	void* __libc_malloc(size_t size);
+	void* __libc_calloc(size_t count, size_t size);
+	void* __libc_realloc(void *pointer, size_t size);
+	void __libc_free(void *pointer);
+}
+
+static std::atomic<uint64_t> allocations(0);
+
+extern "C" void* malloc(size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void *pointer, size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	return __libc_realloc(pointer, size);
+}
+
+extern "C" void free(void *pointer) {
+	__libc_free(pointer);
+}
+
+
+//a basic transaction as it is received, fields out of order
+static const std::string SAMPLE_TRANSACTION = "{\"amount\":150000000,\"type\":\"00\",\"timestamp\":1500000000000000000,\"receiver\":\"C6e7f8a9b0\",\"sender\":\"C1a2b3c4d5\","
+	"\"sig\":\"MEUCIQDwK3F4n1ZyG6c6Y5b9xQ9v0m5n4h3H2g1f0e9d8c7b6QIgB5a4c3d2e1f0a9b8c7d6e5f4a3b2c1d0e9f8a7b6c5d4e3f2\","
+	"\"ib\":{\"account\":\"N6e7f8a9b0\",\"fee\":1000,\"sig\":\"MEUCIQDb2c3d4e5f6a7b8c9d0e1f2a3b4c5d6e7f8a9b0c1d2e3f4a5b6c7QIgD8e9f0a1b2c3d4e5f6a7b8c9d0e1f2a3b4c5d6e7f8a9\"},"
+	"\"ob\":{\"account\":\"N1a2b3c4d5\",\"fee\":1000,\"sig\":\"MEUCIQCa1b2c3d4e5f6a7b8c9d0e1f2a3b4c5d6e7f8a9b0c1d2e3f4a5b6QIgC7d8e9f0a1b2c3d4e5f6a7b8c9d0e1f2a3b4c5d6e7f8\"}}";
+
+int main() {
+	std::vector<Transaction*> kept;
+	kept.reserve(BENCHMARK_TRANSACTIONS);
+	std::vector<std::string> received(BENCHMARK_TRANSACTIONS, SAMPLE_TRANSACTION);
+	int errorCode;
+
+	//the received copies and the container's own storage are set up front
+	uint64_t before = allocations.load();
+	auto start = std::chrono::steady_clock::now();
+
+	for(uint i = 0; i < BENCHMARK_TRANSACTIONS; i++) {
+		Transaction *transaction = Processing::CreateTransaction(nullptr, nullptr, received[i], errorCode);
+		if(errorCode != VALID) {
+			std::cout << "sample transaction rejected: " << errorCode << std::endl;
+			return EXIT_FAILURE;
+		}
+		if(i % BENCHMARK_DETACHED == 0) transaction->Detach();
+
+		//relayed, appended and published from the same canonical form
+		transaction->GetTransaction();
+		kept.push_back(transaction);
+	}
+
+	auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+	uint64_t made = allocations.load() - before;
+
+	std::cout << (TRANSACTION_ARENA_SIZE ? "shared arenas" : "arena per transaction") << std::endl;
+	std::cout << "allocations per transaction: " << (double)made / BENCHMARK_TRANSACTIONS << std::endl;
+	std::cout << "nanoseconds per transaction: " << elapsed / BENCHMARK_TRANSACTIONS << std::endl;
+	std::cout << "serializations: " << Transaction::Serializations() << std::endl;
+
+	for(auto transaction = kept.begin(); transaction != kept.end(); ++transaction) delete *transaction;
+	return EXIT_SUCCESS;
+}
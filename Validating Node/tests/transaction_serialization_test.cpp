@@ -0,0 +1,134 @@
+/*
+	Copyright (c) 2016-2017, Unified Digital Currency
+
+	All rights reserved.
+
+	Redistribution and use in source and binary forms, with or without
+	modification, are permitted provided that the following conditions are met:
+
+	1. Redistributions of source code must retain the above copyright notice, this
+	list of conditions and the following disclaimer.
+
+	2. Redistributions in binary form must reproduce the above copyright notice,
+	this list of conditions and the following disclaimer in the documentation
+	and/or other materials provided with the distribution.
+
+	3. Neither the name of the copyright holder nor the names of its contributors
+	may be used to endorse or promote products derived from this software without
+	specific prior written permission.
+
+	THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+	ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+	WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+	DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+	FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+	DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+	SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+	CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+	OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+	OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+/**
+ * @file transaction_serialization_test.cpp
+ * @author Rafael Afonso Rodrigues <founder@udc.world>
+ * @date 2016
+ * UDC Validating Node.
+ *
+ * Checks that a transaction is serialized only once on its way through the node: admitted, relayed
+ * to the peer nodes, appended to the ledger and published, every step reuses the canonical bytes
+ * MakeHash produced. Build it from the src directory against every source but main.cpp, then run it
+ * from anywhere (the ledger files go to a temporary directory):
+ *   g++ -std=c++11 -pthread -I. ../tests/transaction_serialization_test.cpp $(ls *.cpp | grep -v main.cpp) -lrocksdb -lcryptopp -lboost_filesystem -lboost_regex -lboost_system -o transaction_serialization_test
+ *   ./transaction_serialization_test
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "includes/boost/filesystem.hpp"
+
+#include "admission_control.h"
+#include "codes.h"
+#include "globals.h"
+#include "ledger.h"
+#include "node.h"
+#include "processing.h"
+#include "transaction.h"
+
+#define TEST_TRANSACTIONS		1000
+#define TEST_ENTITY				"E1A2B3C4"
+
+
+//A basic transaction as a managing entity submits it, fields out of order; amounts tell them apart.
+//The ledger isn't synchronized, so it only appends those timestamped before its current window, to the next one
+std::string Submission(uint i) {
+	return "{\"amount\":" + std::to_string(100000 + i) + ",\"type\":\"00\",\"timestamp\":" + std::to_string(GENESIS_LEDGER_END) + ","
+		"\"receiver\":\"C6e7f8a9b0\",\"sender\":\"C1a2b3c4d5\","
+		"\"sig\":\"MEUCIQDwK3F4n1ZyG6c6Y5b9xQ9v0m5n4h3H2g1f0e9d8c7b6QIgB5a4c3d2e1f0a9b8c7d6e5f4a3b2c1d0e9f8a7b6c5d4e3f2\","
+		"\"ib\":{\"account\":\"N6e7f8a9b0\",\"fee\":1000,\"sig\":\"MEUCIQDb2c3d4e5f6a7b8c9d0e1f2a3b4c5d6e7f8a9b0c1d2e3f4a5b6c7QIgD8e9f0a1b2c3d4e5f6a7b8c9d0e1f2a3b4c5d6e7f8a9\"},"
+		"\"ob\":{\"account\":\"N1a2b3c4d5\",\"fee\":1000,\"sig\":\"MEUCIQCa1b2c3d4e5f6a7b8c9d0e1f2a3b4c5d6e7f8a9b0c1d2e3f4a5b6QIgC7d8e9f0a1b2c3d4e5f6a7b8c9d0e1f2a3b4c5d6e7f8\"}}";
+}
+
+int main() {
+	//the ledger writes its files under the working directory
+	boost::filesystem::path directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("transaction_serialization_test_%%%%%%%%");
+	boost::filesystem::create_directories(directory / LOCAL_DATA_LEDGERS);
+	boost::filesystem::current_path(directory);
+
+	AdmissionControl admission;
+	Nodes nodes((std::unordered_map<std::string, NodeStruct>()));
+	Ledger ledger(nullptr, nullptr, nullptr, nullptr, nullptr);
+	ledger.InitializeLedgers(GENESIS_LEDGER_HASH, GENESIS_LEDGER_ID);
+
+	std::vector<Transaction*> transactions;
+	std::vector<std::string> published;
+	uint64_t before = Transaction::Serializations();
+	bool passed = true;
+
+	for(uint i = 0; i < TEST_TRANSACTIONS && passed; i++) {
+		std::string submission = Submission(i);
+		int errorCode = VALID;
+
+		//Admission, as a managing entity's submission is taken in
+		if(!admission.Admit(TEST_ENTITY, 0, errorCode)) {
+			std::cout << "transaction " << i << " not admitted: " << errorCode << std::endl;
+			passed = false;
+			break;
+		}
+		Transaction *transaction = Processing::PrepareTransaction(nullptr, nullptr, submission, errorCode);
+		admission.Complete(TEST_ENTITY);
+		if(errorCode != VALID) {
+			std::cout << "transaction " << i << " rejected: " << errorCode << std::endl;
+			passed = false;
+			break;
+		}
+		transactions.push_back(transaction);
+
+		//Relay, no peer is connected but the message is still put together
+		nodes.BroadcastNewTransaction(transaction);
+
+		//Append
+		ledger.RegisterTransaction(transaction);
+
+		//Publish, the message the processing thread hands to the publisher
+		published.push_back("{\"" + transaction->GetHash() + "\":" + transaction->GetTransaction() + "}");
+	}
+
+	uint64_t serializations = Transaction::Serializations() - before;
+	if(passed && serializations != TEST_TRANSACTIONS) {
+		std::cout << serializations << " serializations for " << TEST_TRANSACTIONS << " transactions" << std::endl;
+		passed = false;
+	}
+
+	for(auto transaction = transactions.begin(); transaction != transactions.end(); ++transaction) delete *transaction;
+	boost::filesystem::current_path(boost::filesystem::temp_directory_path());
+	boost::filesystem::remove_all(directory);
+
+	if(!passed) return EXIT_FAILURE;
+	std::cout << "transaction serialization: " << TEST_TRANSACTIONS << " transactions serialized once each" << std::endl;
+	return EXIT_SUCCESS;
+}